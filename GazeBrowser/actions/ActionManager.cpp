@@ -21,7 +21,7 @@ void ActionManager::setMode(int actionMode) {
     }
 }
 
-void ActionManager::estimatedPoint(cv::Point p) {
+void ActionManager::estimatedPoint(cv::Point p, qint64 captureTick) {
     if (!running)
         return;
 
@@ -36,7 +36,7 @@ void ActionManager::estimatedPoint(cv::Point p) {
         for (iter = actions.begin(); iter != actions.end(); iter++) {
             cv::Rect r = (*iter)->getRegion();
             if (isPointInRect(p, r)) {
-                (*iter)->focus();
+                (*iter)->focus(captureTick);
             } else {
                 (*iter)->unfocus();
             }
@@ -11,7 +11,7 @@
 
 /**
  * The ActionManager class is responsible for enabling / disabling the GazeActions.
- * the slot estimatedPoint(cv::Point) is called for each measured Screen position. 
+ * the slot estimatedPoint(cv::Point, qint64) is called for each measured Screen position. 
  * the manager then calculates which Action is triggered by this measurement and focuses it.
  * using a mode the ActionManager can trigger different GazeActions for the same screen position
  */
@@ -52,8 +52,9 @@ public slots:
     /**
      * accepts measured Gaze positions and executes an action (if any)
      * @param p the position on the screen where the user is looking at
+     * @param captureTick the capture time of the frame (cv::getTickCount()) or 0
      */
-    void estimatedPoint(cv::Point p);
+    void estimatedPoint(cv::Point p, qint64 captureTick);
 
 private:
     std::map<int, std::vector<GazeAction*> > actionMap;
@@ -1,6 +1,7 @@
 #include <iostream>
 
 #include "utils/geometry.hpp"
+#include "utils/log.hpp"
 
 #include "GazeAction.hpp"
 #include "ui/GazePointer.hpp"
@@ -25,7 +26,7 @@ cv::Rect GazeAction::getRegion() const {
     return region;
 }
 
-void GazeAction::focus() {
+void GazeAction::focus(qint64 captureTick) {
     if (timer == NULL){
         timer = new QTime();
         timer->start();
@@ -35,6 +36,10 @@ void GazeAction::focus() {
     
     if (elapsed >= commitTime) {
         //cout << actionName << " commitAction " << endl;  
+        if (captureTick > 0) {
+            LOG_D(actionName << " latency capture to action: "
+                    << (cv::getTickCount() - captureTick) * 1000. / cv::getTickFrequency() << "ms");
+        }
         gazePointer->commitAction(barycenter);
         (browserWindow ->*actionCallback) (barycenter);
         delete timer;
@@ -40,8 +40,10 @@ public:
     /**
      * starts measuring the prepare and commit time<br />commits the action
      * if the commit time has been exceeded
+     * @param captureTick the capture time (cv::getTickCount()) of the frame
+     *  that focused the action or 0. used for logging the latency
      */
-    void focus();
+    void focus(qint64 captureTick = 0);
     
     /**
      * stops measuring the prepare and commit time
@@ -60,7 +60,7 @@ void ThreadManager::setUpSignalHandling() {
     connect(idle, SIGNAL(cvImage(cv::Mat*)), parent, SLOT(showCvImage(cv::Mat*)));
     
     // connect tracker thread with actionmanager to determine gaze action
-    connect(gazeTracker, SIGNAL(estimatedPoint(cv::Point)), parent->actionManager, SLOT(estimatedPoint(cv::Point)));
+    connect(gazeTracker, SIGNAL(estimatedPoint(cv::Point, qint64)), parent->actionManager, SLOT(estimatedPoint(cv::Point, qint64)));
 }
 
 ThreadManager::~ThreadManager() {
@@ -13,14 +13,19 @@
 using namespace std;
 
 GazeTrackWorker::GazeTrackWorker(int width, int height, ImageSource *camera, QMutex *cameraLock)
-: width(width), height(height), camera(camera), cameraLock(cameraLock), running(false) {
+: width(width), height(height), camera(camera), cameraLock(cameraLock), running(false),
+asyncCallback(*this) {
 
-    tracker = new GazeTracker(*camera, this);
+    tracker = new GazeTracker(*camera, &asyncCallback);
+    tracker->setGazeFilter(&gazeFilter);
     calibration = NULL;
 
 }
 
 GazeTrackWorker::~GazeTrackWorker() {
+    // no more callbacks while this worker is destroyed
+    asyncCallback.stop();
+
     delete tracker;
     if (calibration != NULL)
         delete calibration;
@@ -82,6 +87,15 @@ void GazeTrackWorker::startTracking() {
     // Wait with begining of tracking until bookmark page is loaded
     Sleeper::msleep(4000);
 
+    // the settings window changes the GazeConfig
+    try {
+        tracker->setConfig(TrackerConfig());
+    } catch (GazeException &e) {
+        cameraLock->unlock();
+        emit error(e.what());
+        return;
+    }
+
     running = true;
     tracking = true;
 
@@ -97,6 +111,7 @@ void GazeTrackWorker::startTracking() {
             emit error(e.what());
             break; // leave 
         }
+        asyncCallback.flush();
     }
 
     cameraLock->unlock();
@@ -113,6 +128,7 @@ bool GazeTrackWorker::calibrate() {
     int height = this->height - 2 * y_offset;
     int width = this->width - 2 * x_offset;
 
+    tracker->setConfig(TrackerConfig());
     tracker->initializeCalibration();
 
     int retryNum = 0;
@@ -137,7 +153,10 @@ bool GazeTrackWorker::calibrate() {
             
             try {
                 tracker->track(5);
+                // the measurements are collected by the callback thread
+                asyncCallback.flush();
             } catch(GazeException &e){
+                asyncCallback.flush();
                 retryNum++;
                 if(retryNum > 5)
                     throw e;
@@ -169,12 +188,17 @@ bool GazeTrackWorker::imageProcessed(Mat& resultImage) {
 }
 
 bool GazeTrackWorker::imageProcessed(Mat& resultImage, MeasureResult &result, Point2f &gazeVector) {
+    return imageProcessed(resultImage, result, gazeVector, FrameInfo());
+}
+
+bool GazeTrackWorker::imageProcessed(Mat& resultImage, MeasureResult &result, Point2f &gazeVector,
+        const FrameInfo &frameInfo) {
 //#ifdef __APPLE__
 //    Sleeper::msleep(33);
 //#endif
     if (result == MEASURE_OK) {
         if (tracking) {
-            emit estimatedPoint(calibration->calcCoordinates(gazeVector));
+            emit estimatedPoint(calibration->calcCoordinates(gazeVector), frameInfo.captureTick);
         } else {
             measurements.push_back(gazeVector);
         }
@@ -187,6 +211,15 @@ bool GazeTrackWorker::imageProcessed(Mat& resultImage, MeasureResult &result, Po
     return running;
 }
 
+bool GazeTrackWorker::frameProcessed(FrameResult &frameResult) {
+    Mat resultImage;
+    if (!tracking)
+        resultImage = frameResult.renderOverlay();
+
+    return imageProcessed(resultImage, frameResult.result, frameResult.gazeVector,
+            frameResult.frameInfo);
+}
+
 void GazeTrackWorker::stop(PROGRAM_STATES nextState) {
     this->nextStateAfterStop = nextState;
     this->running = false;
@@ -4,6 +4,8 @@
 #include <QtCore>
 #include "video/ImageSource.hpp"
 #include "detection/GazeTracker.hpp"
+#include "detection/AsyncTrackerCallback.hpp"
+#include "filter/GazeFilter.hpp"
 
 #include "../StateMachineDefinition.hpp"
 
@@ -20,6 +22,8 @@ class GazeTracker;
  * when tracking this thread calculates for each frame the point on the screen
  * and emits this estimated point. WHEN TRACKING NO MEASURED IMAGES ARE DISPLAYED 
  * (for speeding up the processing)
+ * <br />the callbacks are delivered by an AsyncTrackerCallback, they run on 
+ * its thread and not on the QThread
  */
 class GazeTrackWorker : public QObject, public TrackerCallback {
     Q_OBJECT
@@ -34,6 +38,11 @@ private:
     bool tracking;
     PROGRAM_STATES nextStateAfterStop;
     GazeTracker *tracker;
+    /// displaying the frames and emitting the points runs on its own thread,
+    /// not in the frame time of the tracker
+    AsyncTrackerCallback asyncCallback;
+    /// smooths the fixations for the dwell time without delaying the saccades
+    OneEuroFilter gazeFilter;
     Calibration *calibration;
     
     bool calibrate();
@@ -61,6 +70,28 @@ public:
      */
     bool imageProcessed(Mat &resultImage, MeasureResult &result, Point2f &gazeVector);
     
+    /**
+     * same as imageProcessed(Mat, MeasureResult, Point2f). the capture time
+     * of the frame is emitted together with the estimated point, this way
+     * the latency between capturing and executing an action can be measured
+     * @param resultImage
+     * @param result
+     * @param gazeVector
+     * @param frameInfo
+     * @return 
+     */
+    bool imageProcessed(Mat &resultImage, MeasureResult &result, Point2f &gazeVector,
+            const FrameInfo &frameInfo);
+
+    /**
+     * renders the overlay of the frame only while calibrating, the tracking
+     * does not display the frames. calls imageProcessed(Mat, MeasureResult, 
+     * Point2f, FrameInfo)
+     * @param frameResult
+     * @return 
+     */
+    bool frameProcessed(FrameResult &frameResult);
+    
     
 public slots:
     /**
@@ -93,7 +124,7 @@ signals:
     void calibrationFinished();
     void cvImage(cv::Mat*);
     void hasStopped(PROGRAM_STATES);
-    void estimatedPoint(cv::Point);
+    void estimatedPoint(cv::Point, qint64);
 
 };
 #endif
\ No newline at end of file
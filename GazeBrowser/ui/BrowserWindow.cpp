@@ -299,6 +299,8 @@ void BrowserWindow::showEvent(QShowEvent *event) {
 void BrowserWindow::setUpCamera() {
 
     source = new LiveSource(cameraChannel);
+    // a stale gaze point is worse than a skipped one
+    source->setDeliveryPolicy(DELIVER_LATEST_FRAME);
     tManager = new ThreadManager(this);
     tManager->goIdle();
 
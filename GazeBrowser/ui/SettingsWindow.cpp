@@ -27,6 +27,23 @@ SettingsWindow::SettingsWindow() {
     btnGroupEye->addButton(rLeftEye);
     btnGroupEye->addButton(rRightEye);
 
+    QLabel *locatorLabel = new QLabel(tr("Eye search"));
+    rLocateByHaar = new QRadioButton(tr("Haar cascades"));
+    connect(rLocateByHaar, SIGNAL(toggled(bool)), this, SLOT(onEyeLocatorToggled()));
+    rLocateByHaar->setAutoExclusive(false);
+    rLocateByGlints = new QRadioButton(tr("Glint pattern"));
+    connect(rLocateByGlints, SIGNAL(toggled(bool)), this, SLOT(onEyeLocatorToggled()));
+    rLocateByHaar->setChecked(!GazeConfig::LOCATE_EYES_BY_GLINTS);
+    rLocateByGlints->setChecked(GazeConfig::LOCATE_EYES_BY_GLINTS);
+
+    eyeBox->addWidget(locatorLabel);
+    eyeBox->addWidget(rLocateByHaar);
+    eyeBox->addWidget(rLocateByGlints);
+
+    QButtonGroup *btnGroupLocator = new QButtonGroup(eyeBox);
+    btnGroupLocator->addButton(rLocateByHaar);
+    btnGroupLocator->addButton(rLocateByGlints);
+
     QGridLayout *starburst = new QGridLayout();
     starburst->addWidget(new QLabel("Starburst Edge Threshold"));
     starburst->addWidget(setUpSpinBox(0, 255, 1, GazeConfig::STARBURST_EDGE_THRESHOLD));
@@ -75,6 +92,11 @@ SettingsWindow::SettingsWindow() {
     haarLayout->addWidget(lHaarEyeRegMinWidth, 1, 0);
     haarLayout->addWidget(sHaarEyeRegMinWidth, 1, 1);
 
+    QLabel *lHaarScale = new QLabel(tr("Scale of the eye region search (%)"));
+    QSpinBox *sHaarScale = setUpSpinBox(10, 100, 5, GazeConfig::HAAR_SCALE_PERCENT);
+    haarLayout->addWidget(lHaarScale, 2, 0);
+    haarLayout->addWidget(sHaarScale, 2, 1);
+
     QLabel *lHaarMaxTries = new QLabel(tr("Max tries to find eye region"));
     QSpinBox *sHaarMaxTries = setUpSpinBox(0, 100, 1, GazeConfig::HAAR_FINDREGION_MAX_TRIES);
     haarLayout->addWidget(lHaarMaxTries, 6, 0);
@@ -112,6 +134,10 @@ void SettingsWindow::onEyeSelectionToggled() {
         GazeConfig::DETECT_LEFT_EYE = false;
 }
 
+void SettingsWindow::onEyeLocatorToggled() {
+    GazeConfig::LOCATE_EYES_BY_GLINTS = rLocateByGlints->isChecked();
+}
+
 SettingsWindow::~SettingsWindow() {
 }
 
@@ -19,10 +19,13 @@ public:
     virtual ~SettingsWindow();
 protected slots:
     void onEyeSelectionToggled();
+    void onEyeLocatorToggled();
 private:
 
     QRadioButton *rLeftEye;
     QRadioButton *rRightEye;
+    QRadioButton *rLocateByHaar;
+    QRadioButton *rLocateByGlints;
 
     QSpinBox * setUpSpinBox(int min, int max, int step, int& default_value);
 };
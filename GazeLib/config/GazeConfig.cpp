@@ -24,11 +24,13 @@ int GazeConfig::GLINT_ANGLE_TOLERANCE;
 int GazeConfig::HAAR_EYEREGION_MIN_HEIGHT;
 int GazeConfig::HAAR_EYEREGION_MIN_WIDTH;
 int GazeConfig::HAAR_FINDREGION_MAX_TRIES;
+int GazeConfig::HAAR_SCALE_PERCENT;
 
 //
 //  General settings
 //
 bool GazeConfig::DETECT_LEFT_EYE; 
+bool GazeConfig::LOCATE_EYES_BY_GLINTS;
 
 string GazeConfig::inHomeDirectory(string suffix) {
 	string home(getenv("HOME"));
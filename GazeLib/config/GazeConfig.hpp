@@ -10,6 +10,10 @@
  * <br />
  * if the GazeLib cannot find either the pupil or the glints you probably need
  * to check the constants in this class.
+ * <br />
+ * the variables are the defaults for new TrackerConfigs. a running 
+ * GazeTracker only sees changes after GazeTracker::setConfig(TrackerConfig()).
+ * @see TrackerConfig
  */
 class GazeConfig {
 public:
@@ -22,12 +26,47 @@ public:
     static const char GLINT_COUNT = 4;
     /// The maximum amount of tries to find the pupil using the starburst algorithm
     static const unsigned int MAX_STARBURST_ITERATIONS = 10;
+    /// the number of rays the starburst algorithm sends out of the start point
+    static const unsigned int STARBURST_RAYS = 20;
     /// The number of RANSAC iterations per frame (and pupil)
     static const unsigned int RANSAC_ITERATIONS = 400;
     /// the number of frames used to smooth the measured gaze signal
     static const unsigned int NUM_OF_SMOOTHING_FRAMES = 5;
     /// the glint size used for removing them in the starburst algorithm
     static const int GLINT_RADIUS = 8;
+    /// the margin (in pixels) around the largest eye region of the next
+    /// frame which the ImageSource is asked to capture while tracking. the
+    /// eye may move this far between two frames
+    static const int REGION_OF_INTEREST_MARGIN = 64;
+    /// the number of frames that may wait between two stages of the
+    /// pipelined tracking. @see GazeTracker::setPipelined()
+    static const unsigned int PIPELINE_QUEUE_SIZE = 2;
+    /// the number of results an AsyncTrackerCallback keeps for a slow
+    /// consumer before it drops them
+    static const unsigned int CALLBACK_QUEUE_SIZE = 8;
+    /// the lowest quality (in percent of the starburst rays, iterations and
+    /// RANSAC iterations) a QualityController falls back to under load
+    static const int QUALITY_MIN_PERCENT = 30;
+    /// a QualityController changes the quality in steps of this many percent
+    static const int QUALITY_STEP_PERCENT = 10;
+    /// the size of the eye region while the head is still, in percent of
+    /// the eye found by the haar classifier. @see RegionPredictor
+    static const int REGION_MIN_SCALE_PERCENT = 75;
+    /// the maximum size of the eye region while the head moves or the
+    /// glints are lost, in percent of the eye found by the haar classifier
+    static const int REGION_MAX_SCALE_PERCENT = 150;
+    /// the eye region covers the predicted glint center +- this many
+    /// standard deviations
+    static const int REGION_PREDICTION_SIGMAS = 3;
+    /// the GlintPatternLocator searches the glints in a copy of the frame
+    /// scaled to this many percent
+    static const int GLINT_LOCATOR_SCALE_PERCENT = 50;
+    /// the size of the eye region proposed by the GlintPatternLocator, in
+    /// glint distances
+    static const int GLINT_LOCATOR_EYE_SIZE = 6;
+    /// the EyeTemplateTracker searches the eye in copies of the eye region
+    /// scaled to this many percent
+    static const int EYE_TEMPLATE_SCALE_PERCENT = 50;
 
     //
     // Starburst 
@@ -60,9 +99,15 @@ public:
     /// the maximum number of tries to finde the eye region
     /// @see EyeRegionNotFoundException
     static int HAAR_FINDREGION_MAX_TRIES;
+    /// the eye pair classifier searches a copy of the frame scaled to this
+    /// many percent (100 for the full resolution)
+    static int HAAR_SCALE_PERCENT;
 
     /// configures whether the gaze tracking should measure the left or right eye
     static bool DETECT_LEFT_EYE;
+    /// true to locate the eyes by their glint pattern instead of the haar
+    /// classifiers. @see GlintPatternLocator
+    static bool LOCATE_EYES_BY_GLINTS;
 
     GazeConfig() {
         initConiguration();
@@ -96,9 +141,11 @@ public:
         GazeConfig::HAAR_EYEREGION_MIN_HEIGHT = 200;
         GazeConfig::HAAR_EYEREGION_MIN_WIDTH = 600;
         GazeConfig::HAAR_FINDREGION_MAX_TRIES = 10;
+        GazeConfig::HAAR_SCALE_PERCENT = 50;
 
         // General Settings
         GazeConfig::DETECT_LEFT_EYE = true;
+        GazeConfig::LOCATE_EYES_BY_GLINTS = false;
 
     }
 
@@ -0,0 +1,67 @@
+#ifndef TRACKERCONFIG_HPP_
+#define TRACKERCONFIG_HPP_
+
+#include "GazeConfig.hpp"
+
+/**
+ * the TrackerConfig holds the tuning values of one GazeTracker. every
+ * tracker owns a copy and hands it to its FindGlints, Starburst, Ransac and
+ * FindEyeRegion, so several trackers can run in one process (and on
+ * different threads) without interfering.
+ * <br />a new TrackerConfig starts with the current values of the
+ * GazeConfig, changing the GazeConfig afterwards does not change it.
+ * @see GazeConfig
+ */
+struct TrackerConfig {
+    /// @see GazeConfig::STARBURST_EDGE_THRESHOLD
+    int starburstEdgeThreshold;
+    /// @see GazeConfig::STARBURST_RAYS
+    unsigned int starburstRays;
+    /// @see GazeConfig::MAX_STARBURST_ITERATIONS
+    unsigned int starburstIterations;
+    /// @see GazeConfig::RANSAC_ITERATIONS
+    unsigned int ransacIterations;
+
+    /// @see GazeConfig::GLINT_THRESHOLD
+    int glintThreshold;
+    /// @see GazeConfig::GLINT_DISTANCE_TOLERANCE
+    int glintDistanceTolerance;
+    /// the initial glint distance, FindGlints adapts it to the measured glints
+    /// @see GazeConfig::GLINT_DISTANCE
+    int glintDistance;
+    /// @see GazeConfig::GLINT_ANGLE_TOLERANCE
+    int glintAngleTolerance;
+
+    /// @see GazeConfig::HAAR_EYEREGION_MIN_HEIGHT
+    int haarEyeRegionMinHeight;
+    /// @see GazeConfig::HAAR_EYEREGION_MIN_WIDTH
+    int haarEyeRegionMinWidth;
+    /// @see GazeConfig::HAAR_FINDREGION_MAX_TRIES
+    int haarFindRegionMaxTries;
+    /// @see GazeConfig::HAAR_SCALE_PERCENT
+    int haarScalePercent;
+
+    /// @see GazeConfig::DETECT_LEFT_EYE
+    bool detectLeftEye;
+    /// @see GazeConfig::LOCATE_EYES_BY_GLINTS
+    bool locateEyesByGlints;
+
+    TrackerConfig() :
+    starburstEdgeThreshold(GazeConfig::STARBURST_EDGE_THRESHOLD),
+    starburstRays(GazeConfig::STARBURST_RAYS),
+    starburstIterations(GazeConfig::MAX_STARBURST_ITERATIONS),
+    ransacIterations(GazeConfig::RANSAC_ITERATIONS),
+    glintThreshold(GazeConfig::GLINT_THRESHOLD),
+    glintDistanceTolerance(GazeConfig::GLINT_DISTANCE_TOLERANCE),
+    glintDistance(GazeConfig::GLINT_DISTANCE),
+    glintAngleTolerance(GazeConfig::GLINT_ANGLE_TOLERANCE),
+    haarEyeRegionMinHeight(GazeConfig::HAAR_EYEREGION_MIN_HEIGHT),
+    haarEyeRegionMinWidth(GazeConfig::HAAR_EYEREGION_MIN_WIDTH),
+    haarFindRegionMaxTries(GazeConfig::HAAR_FINDREGION_MAX_TRIES),
+    haarScalePercent(GazeConfig::HAAR_SCALE_PERCENT),
+    detectLeftEye(GazeConfig::DETECT_LEFT_EYE),
+    locateEyesByGlints(GazeConfig::LOCATE_EYES_BY_GLINTS) {
+    }
+};
+
+#endif /* TRACKERCONFIG_HPP_ */
@@ -0,0 +1,130 @@
+#include "AsyncTrackerCallback.hpp"
+#include "../utils/log.hpp"
+
+AsyncTrackerCallback::AsyncTrackerCallback(TrackerCallback& consumer,
+        unsigned int capacity) : consumer(consumer), events(capacity),
+continueTracking(true), queuedEvents(0), droppedResults(0),
+pendingDroppedFrames(0), pendingSequenceNumber(0), deliveredEvents(0),
+stopped(false) {
+    start();
+}
+
+AsyncTrackerCallback::~AsyncTrackerCallback() {
+    stop();
+}
+
+void AsyncTrackerCallback::stop() {
+    events.close();
+    join();
+}
+
+bool AsyncTrackerCallback::enqueue(CallbackEvent& event) {
+    // a dropped result must not cost a copy of the image
+    if (!events.hasSpace()) {
+        ++droppedResults;
+        LOG_D("The consumer is too slow, dropped results: " << droppedResults);
+        return continueTracking;
+    }
+
+    // the tracker may reuse the frame buffer as soon as we return
+    event.frameResult.image = event.frameResult.image.clone();
+    event.droppedFrames = pendingDroppedFrames;
+    event.droppedSequenceNumber = pendingSequenceNumber;
+
+    // only stop() can take the space away
+    if (events.tryPush(event)) {
+        ++queuedEvents;
+        pendingDroppedFrames = 0;
+    } else {
+        ++droppedResults;
+    }
+
+    return continueTracking;
+}
+
+bool AsyncTrackerCallback::imageProcessed(Mat& resultImage) {
+    CallbackEvent event;
+    event.frameResult.image = resultImage;
+    return enqueue(event);
+}
+
+bool AsyncTrackerCallback::imageProcessed(Mat& resultImage,
+        MeasureResult& result, Point2f& gazeVector) {
+    CallbackEvent event;
+    event.call = CallbackEvent::MEASURE_PROCESSED;
+    event.frameResult.image = resultImage;
+    event.frameResult.result = result;
+    event.frameResult.gazeVector = gazeVector;
+    return enqueue(event);
+}
+
+bool AsyncTrackerCallback::frameProcessed(FrameResult& frameResult) {
+    CallbackEvent event;
+    event.call = CallbackEvent::FRAME_PROCESSED;
+    event.frameResult = frameResult;
+    return enqueue(event);
+}
+
+void AsyncTrackerCallback::framesDropped(unsigned long numOfFrames,
+        unsigned long sequenceNumber) {
+    // reported with the next result which makes it into the queue
+    pendingDroppedFrames += numOfFrames;
+    pendingSequenceNumber = sequenceNumber;
+}
+
+void AsyncTrackerCallback::eyesMeasured(const EyeMeasurement eyes[NUM_OF_EYES],
+        const FrameInfo& frameInfo) {
+}
+
+void AsyncTrackerCallback::deliver(CallbackEvent& event) {
+    if (event.droppedFrames > 0)
+        consumer.framesDropped(event.droppedFrames, event.droppedSequenceNumber);
+
+    FrameResult& frameResult = event.frameResult;
+    switch (event.call) {
+        case CallbackEvent::IMAGE_PROCESSED:
+            continueTracking = consumer.imageProcessed(frameResult.image);
+            break;
+        case CallbackEvent::MEASURE_PROCESSED:
+            continueTracking = consumer.imageProcessed(frameResult.image,
+                    frameResult.result, frameResult.gazeVector);
+            break;
+        case CallbackEvent::FRAME_PROCESSED:
+            if (frameResult.binocular)
+                consumer.eyesMeasured(frameResult.eyes, frameResult.frameInfo);
+            continueTracking = consumer.frameProcessed(frameResult);
+            break;
+    }
+}
+
+void AsyncTrackerCallback::run() {
+    CallbackEvent event;
+    while (events.pop(event)) {
+        deliver(event);
+
+        ScopedLock lock(mutex);
+        ++deliveredEvents;
+        delivered.broadcast();
+    }
+
+    // flush() must not wait for results which are never delivered
+    ScopedLock lock(mutex);
+    stopped = true;
+    delivered.broadcast();
+}
+
+bool AsyncTrackerCallback::flush() {
+    {
+        ScopedLock lock(mutex);
+        while (!stopped && deliveredEvents < queuedEvents)
+            delivered.wait(mutex);
+    }
+
+    bool answer = continueTracking;
+    continueTracking = true;
+    return answer;
+}
+
+unsigned long AsyncTrackerCallback::getDroppedResults() const {
+    return droppedResults;
+}
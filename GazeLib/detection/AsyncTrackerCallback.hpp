@@ -0,0 +1,128 @@
+#ifndef ASYNCTRACKERCALLBACK_HPP_
+#define ASYNCTRACKERCALLBACK_HPP_
+
+#include "GazeTracker.hpp"
+#include "../utils/LockFreeQueue.hpp"
+#include "../utils/threads.hpp"
+
+/**
+ * The AsyncTrackerCallback delivers the results of a GazeTracker to another
+ * TrackerCallback (the consumer) on its own thread. the GazeTracker only
+ * copies the FrameResult into a LockFreeQueue, so a slow consumer (e.g. one
+ * which displays every frame) does not slow down the tracking. if the queue
+ * is full the result is dropped and counted instead.
+ * <br />the answer of the consumer whether the tracking should continue is
+ * returned by the next call of the GazeTracker, so the tracking stops a few
+ * frames after the consumer has asked for it.
+ * <br />dropped frames of the ImageSource are reported to the consumer before
+ * the next delivered result. in the binocular tracking eyesMeasured() is
+ * called with the eyes of the FrameResult before frameProcessed().
+ *
+ * usage:
+ * <pre>
+ * AsyncTrackerCallback async(consumer);
+ * GazeTracker tracker(source, &async);
+ * tracker.track(5);
+ * async.flush(); // all results have been delivered to the consumer
+ * </pre>
+ */
+class AsyncTrackerCallback : public TrackerCallback, private Thread {
+private:
+    /**
+     * a call of the GazeTracker on its way to the consumer
+     */
+    struct CallbackEvent {
+        enum Call {
+            IMAGE_PROCESSED,
+            MEASURE_PROCESSED,
+            FRAME_PROCESSED,
+        };
+        /// the method of the consumer which gets the event
+        Call call;
+        /// the result (or only the image) of the frame
+        FrameResult frameResult;
+        /// the number of frames the source dropped before this frame
+        unsigned long droppedFrames;
+        unsigned long droppedSequenceNumber;
+
+        CallbackEvent() : call(IMAGE_PROCESSED), droppedFrames(0), droppedSequenceNumber(0) {
+        }
+    };
+
+    TrackerCallback& consumer;
+    LockFreeQueue<CallbackEvent> events;
+
+    /// the last answer of the consumer
+    volatile bool continueTracking;
+
+    /// written by the thread of the GazeTracker only
+    unsigned long queuedEvents;
+    unsigned long droppedResults;
+    unsigned long pendingDroppedFrames;
+    unsigned long pendingSequenceNumber;
+
+    /// written by the delivery thread, protected by mutex
+    unsigned long deliveredEvents;
+    bool stopped;
+    Mutex mutex;
+    Condition delivered;
+
+    bool enqueue(CallbackEvent& event);
+    void deliver(CallbackEvent& event);
+
+protected:
+    void run();
+
+public:
+    /**
+     * starts the delivery thread
+     * @param consumer the callback which gets the results. it is called on
+     *  the delivery thread only
+     * @param capacity the number of results which may wait for the consumer
+     */
+    AsyncTrackerCallback(TrackerCallback& consumer,
+            unsigned int capacity = GazeConfig::CALLBACK_QUEUE_SIZE);
+
+    /**
+     * delivers the queued results and stops the delivery thread
+     */
+    virtual ~AsyncTrackerCallback();
+
+    bool imageProcessed(Mat &resultImage);
+    bool imageProcessed(Mat &resultImage, MeasureResult &result, Point2f &gazeVector);
+    bool frameProcessed(FrameResult &frameResult);
+    void framesDropped(unsigned long numOfFrames, unsigned long sequenceNumber);
+
+    /**
+     * the eyes are part of the FrameResult, they are delivered with it
+     */
+    void eyesMeasured(const EyeMeasurement eyes[NUM_OF_EYES],
+            const FrameInfo &frameInfo);
+
+    /**
+     * blocks until all queued results have been delivered. call it after
+     * GazeTracker::track() has returned, before the results of the consumer
+     * are used or the tracking is started again: the next tracking starts
+     * with a fresh answer of the consumer.
+     * <br />must be called on the thread of the GazeTracker
+     * @return the last answer of the consumer whether the tracking should
+     *  continue
+     */
+    bool flush();
+
+    /**
+     * delivers the queued results and stops the delivery thread. the
+     * results of the GazeTracker are dropped from now on.
+     * <br />the destructor calls stop(), call it earlier if the consumer is
+     * destroyed before this callback
+     */
+    void stop();
+
+    /**
+     * @return the number of results which have been dropped because the
+     *  consumer was too slow
+     */
+    unsigned long getDroppedResults() const;
+};
+
+#endif /* ASYNCTRACKERCALLBACK_HPP_ */
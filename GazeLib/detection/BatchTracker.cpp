@@ -0,0 +1,286 @@
+#include <unistd.h>
+
+#include "BatchTracker.hpp"
+#include "../video/MmapFrameSource.hpp"
+#include "../video/VideoSource.hpp"
+#include "../exception/GazeExceptions.hpp"
+
+using namespace std;
+using namespace cv;
+
+const unsigned long BatchTracker::DEFAULT_CHUNK_SIZE;
+const unsigned long BatchTracker::WARMUP_FRAMES;
+
+/**
+ * opens a recording and seeks to the frames of a chunk. raw frame files are
+ * replayed with a MmapFrameSource, everything else with a VideoSource
+ */
+class Recording {
+private:
+    MmapFrameSource *rawSource;
+    VideoSource *videoSource;
+
+    Recording(const Recording&);
+    Recording& operator=(const Recording&);
+public:
+
+    Recording(string path) : rawSource(NULL), videoSource(NULL) {
+        if (MmapFrameSource::isRawFrameFile(path))
+            rawSource = new MmapFrameSource(path);
+        else
+            videoSource = new VideoSource(path);
+    }
+
+    ~Recording() {
+        delete rawSource;
+        delete videoSource;
+    }
+
+    ImageSource& source() {
+        if (rawSource != NULL)
+            return *rawSource;
+        return *videoSource;
+    }
+
+    unsigned long frameCount() const {
+        if (rawSource != NULL)
+            return rawSource->frameCount();
+        return videoSource->frameCount();
+    }
+
+    void seek(unsigned long frameIndex) {
+        if (rawSource != NULL)
+            rawSource->seek(frameIndex);
+        else if (!videoSource->seek(frameIndex))
+            throw GazeException("The video cannot seek, it cannot be processed in chunks");
+    }
+};
+
+/**
+ * delivers the frames of one chunk and remembers the index of the last frame
+ */
+class ChunkSource : public ImageSource {
+private:
+    ImageSource& source;
+    unsigned long nextFrame;
+    unsigned long endFrame;
+
+public:
+
+    ChunkSource(ImageSource& source) : source(source), nextFrame(0), endFrame(0) {
+    }
+
+    void setChunk(unsigned long firstFrame, unsigned long endFrame) {
+        this->nextFrame = firstFrame;
+        this->endFrame = endFrame;
+    }
+
+    virtual bool nextGrayFrame(Mat& frame) {
+        if (nextFrame >= endFrame || !source.nextGrayFrame(frame))
+            return false;
+
+        frameInfo = source.lastFrameInfo();
+        sequenceNumber = frameInfo.sequenceNumber;
+        ++nextFrame;
+        return true;
+    }
+
+    virtual void setRegionOfInterest(const Rect& roi) {
+        source.setRegionOfInterest(roi);
+    }
+
+    /**
+     * @return the index of the frame returned by the last nextGrayFrame()
+     */
+    unsigned long lastFrameIndex() const {
+        return nextFrame - 1;
+    }
+
+    bool isDone() const {
+        return nextFrame >= endFrame;
+    }
+};
+
+/**
+ * writes the results of the GazeTracker into the trace and stops the
+ * tracking at the end of the chunk
+ */
+class ChunkCallback : public TrackerCallback {
+private:
+    ChunkSource& source;
+    vector<GazeSample>& trace;
+    unsigned long firstFrame;
+
+public:
+
+    ChunkCallback(ChunkSource& source, vector<GazeSample>& trace) :
+    source(source), trace(trace), firstFrame(0) {
+    }
+
+    void setFirstFrame(unsigned long firstFrame) {
+        this->firstFrame = firstFrame;
+    }
+
+    virtual bool imageProcessed(Mat &resultImage) {
+        return true;
+    }
+
+    virtual bool imageProcessed(Mat &resultImage, MeasureResult &result, Point2f &gazeVector) {
+        return true;
+    }
+
+    /// the frames are not displayed, so no overlay is rendered
+    virtual bool frameProcessed(FrameResult &frameResult) {
+        unsigned long frameIndex = source.lastFrameIndex();
+
+        // the warmup frames belong to the previous chunk
+        if (frameIndex >= firstFrame && frameIndex < trace.size()) {
+            GazeSample& sample = trace[frameIndex];
+            sample.measured = true;
+            sample.result = frameResult.result;
+            sample.gazeVector = frameResult.gazeVector;
+            sample.frameInfo = frameResult.frameInfo;
+        }
+
+        return !source.isDone();
+    }
+};
+
+/**
+ * tracks chunks of the recording until there are no chunks left
+ */
+class BatchWorker : public Thread {
+private:
+    BatchTracker& batch;
+    vector<GazeSample>& trace;
+
+    void processChunks();
+protected:
+    void run();
+public:
+    bool failed;
+    string errorMsg;
+
+    BatchWorker(BatchTracker& batch, vector<GazeSample>& trace) :
+    batch(batch), trace(trace), failed(false) {
+    }
+
+    ~BatchWorker() {
+        join();
+    }
+};
+
+void BatchWorker::run() {
+    try {
+        processChunks();
+    } catch (std::exception &e) {
+        // process() throws it on the calling thread
+        failed = true;
+        errorMsg = e.what();
+    }
+}
+
+void BatchWorker::processChunks() {
+    // one recording per worker, it is reused for every chunk
+    Recording recording(batch.recordingPath);
+    ChunkSource source(recording.source());
+    ChunkCallback callback(source, trace);
+
+    unsigned long firstFrame;
+    unsigned long endFrame;
+    while (batch.takeChunk(firstFrame, endFrame)) {
+        unsigned long warmup = min(firstFrame, BatchTracker::WARMUP_FRAMES);
+
+        recording.seek(firstFrame - warmup);
+        source.setChunk(firstFrame - warmup, endFrame);
+        callback.setFirstFrame(firstFrame);
+
+        // a new GazeTracker for every chunk, nothing of the chunk this worker
+        // has tracked before (smoothing, search hints, ...) changes the trace.
+        // the cascades of the last tracker are taken from the CascadeCache
+        GazeTracker tracker(source, &callback, batch.config);
+        // a found eye region is adopted on the frame it has been found in,
+        // not on the frame on which a background search happens to be done.
+        // this also keeps the workers from starting an eye search thread each
+        tracker.setSynchronousEyeSearch(true);
+
+        while (!source.isDone()) {
+            try {
+                tracker.track();
+            } catch (EyeRegionNotFoundException &e) {
+                // the frames without an eye stay unmeasured
+            } catch (NoImageSourceException &e) {
+                break; // the chunk (or the recording) ended early
+            }
+        }
+    }
+}
+
+BatchTracker::BatchTracker(string recordingPath, unsigned int numOfWorkers,
+        unsigned long chunkSize, const TrackerConfig& config) :
+recordingPath(recordingPath), numOfWorkers(numOfWorkers),
+chunkSize(max(chunkSize, 1ul)), config(config), nextChunk(0) {
+
+    if (this->numOfWorkers == 0) {
+        long cores = sysconf(_SC_NPROCESSORS_ONLN);
+        this->numOfWorkers = cores > 0 ? cores : 1;
+    }
+
+    Recording recording(recordingPath);
+    numOfFrames = recording.frameCount();
+    if (numOfFrames == 0)
+        throw NoImageSourceException();
+}
+
+BatchTracker::~BatchTracker() {
+}
+
+unsigned long BatchTracker::frameCount() const {
+    return numOfFrames;
+}
+
+unsigned int BatchTracker::workerCount() const {
+    return numOfWorkers;
+}
+
+bool BatchTracker::takeChunk(unsigned long& firstFrame, unsigned long& endFrame) {
+    ScopedLock lock(mutex);
+    if (nextChunk >= numOfFrames)
+        return false;
+
+    firstFrame = nextChunk;
+    endFrame = min(nextChunk + chunkSize, numOfFrames);
+    nextChunk = endFrame;
+    return true;
+}
+
+void BatchTracker::process(vector<GazeSample>& trace) {
+    trace.assign(numOfFrames, GazeSample());
+    for (unsigned long i = 0; i < numOfFrames; ++i)
+        trace[i].frameIndex = i;
+
+    nextChunk = 0;
+
+    // the workers write into disjoint parts of the trace
+    vector<BatchWorker*> workers;
+    for (unsigned int i = 0; i < numOfWorkers; ++i)
+        workers.push_back(new BatchWorker(*this, trace));
+
+    string errorMsg;
+    try {
+        for (unsigned int i = 0; i < workers.size(); ++i)
+            workers[i]->start();
+    } catch (GazeException &e) {
+        errorMsg = e.what();
+    }
+
+    for (unsigned int i = 0; i < workers.size(); ++i) {
+        workers[i]->join();
+        if (workers[i]->failed)
+            errorMsg = workers[i]->errorMsg;
+        delete workers[i];
+    }
+
+    if (!errorMsg.empty())
+        throw GazeException(errorMsg);
+}
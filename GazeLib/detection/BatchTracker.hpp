@@ -0,0 +1,110 @@
+#ifndef BATCHTRACKER_HPP_
+#define BATCHTRACKER_HPP_
+
+#include <string>
+#include <vector>
+
+#include "opencv2/core/core.hpp"
+
+#include "GazeTracker.hpp"
+#include "../video/FrameInfo.hpp"
+#include "../utils/threads.hpp"
+
+/**
+ * the measurement of a single frame of a recording
+ */
+struct GazeSample {
+    /// the index of the frame in the recording (the first frame is 0)
+    unsigned long frameIndex;
+    /// false if the frame has not been measured, e.g. because the GazeTracker
+    /// was searching the eye region
+    bool measured;
+    /// the result of the measurement (only valid if measured)
+    MeasureResult result;
+    /// the smoothed GazeVector (only valid if result == MEASURE_OK)
+    cv::Point2f gazeVector;
+    /// the capture time and sequence number of the frame
+    FrameInfo frameInfo;
+
+    GazeSample() : frameIndex(0), measured(false), result(MEASURE_OK) {
+    }
+};
+
+/**
+ * The BatchTracker measures a whole recording (a video file or a raw frame
+ * file written by the RawFrameRecorder) as fast as possible instead of in
+ * real time.
+ * <br />the recording is split into chunks. a worker thread per core takes
+ * the next unprocessed chunk, seeks to it and tracks it with a new
+ * GazeTracker (and therefore new FindGlints and Starburst). the trackers
+ * search a lost eye synchronously (GazeTracker::setSynchronousEyeSearch()),
+ * so the trace does not depend on which worker has tracked which chunk nor
+ * on the timing of the threads. the result is a
+ * gaze trace with one GazeSample per frame, in frame order.
+ * <br />every chunk is started a few frames early, so the eye region is
+ * found and the smoothing is filled before the first frame of the chunk.
+ *
+ * usage:
+ * <pre>
+ * BatchTracker batch("session.raw");
+ * vector<GazeSample> trace;
+ * batch.process(trace);
+ * </pre>
+ */
+class BatchTracker {
+    friend class BatchWorker;
+private:
+    std::string recordingPath;
+    unsigned int numOfWorkers;
+    unsigned long chunkSize;
+    unsigned long numOfFrames;
+    /// every worker starts with a copy of this config
+    TrackerConfig config;
+
+    /// guards nextChunk
+    Mutex mutex;
+    /// the first frame of the next unprocessed chunk
+    unsigned long nextChunk;
+
+    bool takeChunk(unsigned long& firstFrame, unsigned long& endFrame);
+
+    BatchTracker(const BatchTracker&);
+    BatchTracker& operator=(const BatchTracker&);
+public:
+    /// the default number of frames per chunk
+    static const unsigned long DEFAULT_CHUNK_SIZE = 500;
+    /// the number of frames a chunk is started before its first frame
+    static const unsigned long WARMUP_FRAMES = 2 * GazeConfig::NUM_OF_SMOOTHING_FRAMES;
+
+    /**
+     * @param recordingPath a video file or a raw frame file
+     * @param numOfWorkers the number of worker threads (0 for one per core)
+     * @param chunkSize the number of frames per chunk
+     * @param config the config of the GazeTrackers
+     * @throws NoImageSourceException if the recording cannot be opened or
+     *  its length is unknown
+     */
+    BatchTracker(std::string recordingPath, unsigned int numOfWorkers = 0,
+            unsigned long chunkSize = DEFAULT_CHUNK_SIZE,
+            const TrackerConfig& config = TrackerConfig());
+    virtual ~BatchTracker();
+
+    /**
+     * measures every frame of the recording. blocks until all workers are done
+     * @param trace the gaze trace, one GazeSample per frame in frame order
+     * @throws GazeException if a worker has failed
+     */
+    void process(std::vector<GazeSample>& trace);
+
+    /**
+     * @return the number of frames in the recording
+     */
+    unsigned long frameCount() const;
+
+    /**
+     * @return the number of worker threads
+     */
+    unsigned int workerCount() const;
+};
+
+#endif /* BATCHTRACKER_HPP_ */
@@ -0,0 +1,36 @@
+#include "FrameResult.hpp"
+#include "../utils/gui.hpp"
+
+using namespace cv;
+
+static void drawGlints(Mat& image, Point2f glintCenter) {
+    cross(image, glintCenter, 10);
+}
+
+static void drawPupil(Mat& image, Point2f pupilCenter, float pupilRadius) {
+    circle(image, pupilCenter, pupilRadius, Scalar(255, 255, 255));
+    cross(image, pupilCenter, 5);
+}
+
+Mat FrameResult::renderOverlay() const {
+    Mat overlay = image.clone();
+    Point2f origin(region.x, region.y);
+
+    if (binocular) {
+        for (int eye = 0; eye < NUM_OF_EYES; ++eye) {
+            const EyeMeasurement& measured = eyes[eye];
+            if (measured.result != FINDGLINT_FAILED)
+                drawGlints(overlay, measured.glintCenter - origin);
+            if (measured.result == MEASURE_OK)
+                drawPupil(overlay, measured.pupilCenter - origin, measured.pupilRadius);
+        }
+        return overlay;
+    }
+
+    if (result != FINDGLINT_FAILED)
+        drawGlints(overlay, glintCenter - origin);
+    if (result == MEASURE_OK)
+        drawPupil(overlay, pupilCenter - origin, pupilRadius);
+
+    return overlay;
+}
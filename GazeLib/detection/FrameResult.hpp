@@ -0,0 +1,110 @@
+#ifndef FRAMERESULT_HPP_
+#define FRAMERESULT_HPP_
+
+#include <vector>
+
+#include <opencv2/core/core.hpp>
+
+#include "../video/FrameInfo.hpp"
+#include "../utils/latency.hpp"
+
+/**
+ * the result of each measure
+ */
+enum MeasureResult {
+    MEASURE_OK,
+    FINDPUPIL_FAILED,
+    FINDGLINT_FAILED,
+};
+
+/**
+ * the eyes in the binocular tracking. the left eye is the one in the left 
+ * half of the image
+ */
+enum Eye {
+    LEFT_EYE,
+    RIGHT_EYE,
+    NUM_OF_EYES,
+};
+
+/**
+ * the measure result of one eye in the binocular tracking. all positions are
+ * in full frame coordinates
+ */
+struct EyeMeasurement {
+    /// whether the glints and the pupil of this eye have been found
+    MeasureResult result;
+    /// the GazeVector of this eye (only valid if result==MEASURE_OK)
+    cv::Point2f gazeVector;
+    /// the weight of this eye in the fused GazeVector. 0 if the eye has not
+    /// been measured, 1 if the GazeVector agrees with the last one of this eye
+    float confidence;
+    /// the tracked region of this eye
+    cv::Rect region;
+    /// the glints and their center (only valid if result!=FINDGLINT_FAILED)
+    std::vector<cv::Point> glints;
+    cv::Point2f glintCenter;
+    /// the pupil (only valid if result==MEASURE_OK)
+    cv::Point2f pupilCenter;
+    float pupilRadius;
+
+    EyeMeasurement() : result(FINDGLINT_FAILED), confidence(0), pupilRadius(0) {
+    }
+};
+
+/**
+ * The FrameResult holds everything the GazeTracker has measured in a frame.
+ * all positions are in full frame coordinates, so clients can use the
+ * measurements without looking at the image.
+ * <br />the GazeTracker does not draw into the frames. renderOverlay() draws
+ * the glints and the pupil into a copy of the image, only clients which
+ * display the frames need to call it.
+ * @see TrackerCallback::frameProcessed()
+ */
+struct FrameResult {
+    /// whether the glints and the pupil have been found
+    MeasureResult result;
+    /// the smoothed GazeVector (only valid if result==MEASURE_OK)
+    cv::Point2f gazeVector;
+    /// the GazeVector of this frame before the smoothing
+    cv::Point2f measuredGazeVector;
+    /// between 0 and 1: how well the GazeVector agrees with the last one. a
+    /// GazeVector jumping by the distance of the glints is most likely a 
+    /// wrong pupil. 0 if result!=MEASURE_OK
+    float confidence;
+    /// the region of the frame which has been measured
+    cv::Rect region;
+    /// the glints and their center (only valid if result!=FINDGLINT_FAILED)
+    std::vector<cv::Point> glints;
+    cv::Point2f glintCenter;
+    /// the pupil (only valid if result==MEASURE_OK)
+    cv::Point2f pupilCenter;
+    float pupilRadius;
+    /// true if the frame has been measured by the binocular tracking. the
+    /// glints and the pupils are in eyes then, the GazeVector and the
+    /// confidence are fused from both eyes
+    bool binocular;
+    EyeMeasurement eyes[NUM_OF_EYES];
+    /// the capture time, sequence number and measure time of the frame
+    FrameInfo frameInfo;
+    /// the durations of the stages while processing this frame (the 
+    /// TrackerCallback is not included)
+    FrameTimings timings;
+    /// the quality of the pupil search in percent, below 100 if a 
+    /// QualityController has shed work. @see QualityController
+    int qualityPercent;
+    /// the measured region of the frame as delivered by the ImageSource
+    cv::Mat image;
+
+    FrameResult() : result(FINDGLINT_FAILED), confidence(0), pupilRadius(0),
+    binocular(false), qualityPercent(100) {
+    }
+
+    /**
+     * draws the glint center and the pupil into a copy of the image
+     * @return the image with the overlay
+     */
+    cv::Mat renderOverlay() const;
+};
+
+#endif /* FRAMERESULT_HPP_ */
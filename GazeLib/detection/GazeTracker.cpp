@@ -1,7 +1,9 @@
+#include <cmath>
+
 #include "GazeTracker.hpp"
 #include "../utils/geometry.hpp"
-#include "../utils/gui.hpp"
 #include "../utils/log.hpp"
+#include "../utils/latency.hpp"
 #include "../exception/GazeExceptions.hpp"
 
 //#if __DEBUG_FINDGLINTS == 1 || __DEBUG_TRACKER == 1
@@ -10,20 +12,153 @@
 
 using namespace cv;
 
-GazeTracker::GazeTracker(ImageSource & imageSource, TrackerCallback *callback) :
-imageSrc(imageSource), tracker_callback(callback), isRunning(false), framenumber(
-0), eyeFinder(FindEyeRegion(glintFinder)) {
+/// the number of frames without glints before the eye region is searched again
+static const int MAX_FRAMES_WITHOUT_GLINTS = 20;
+/// the windows around the last glint center in which lost glints are 
+/// searched while the haar classifiers run, in percent of the eye size
+static const int REACQUIRE_SCALE_PERCENT[] = {200, 300, 400};
+static const int NUM_OF_REACQUIRE_STAGES = 3;
+/// the number of frames searched in each window (a blink takes some frames)
+static const int REACQUIRE_FRAMES_PER_STAGE = 2;
+/// the eyeTemplate confirms the eye region for this many frames in a row,
+/// glints hidden for longer are lost
+static const int MAX_FRAMES_ON_TEMPLATE = 30;
+/// the size of the eye template in percent of the eye size
+static const int EYE_TEMPLATE_SIZE_PERCENT = 50;
+/// the confidence of a measured eye never drops below this value
+static const float MIN_EYE_CONFIDENCE = 0.01f;
+/// how fast the bias between the GazeVectors of the eyes adapts
+static const float EYE_BIAS_ADAPTION = 0.1f;
+
+/**
+ * the eye cannot move much between two frames, a GazeVector jumping by the
+ * distance of the glints is most likely a wrong pupil
+ * @param jump the distance to the last GazeVector
+ * @param glintDistance the distance of the glints
+ * @return the confidence of the GazeVector between MIN_EYE_CONFIDENCE and 1
+ */
+static float jumpConfidence(double jump, double glintDistance) {
+    double scale = max(glintDistance, 1.);
+    return max((float) exp(-jump / scale), MIN_EYE_CONFIDENCE);
+}
+
+/**
+ * copies the glints found in the eye region to the FrameResult
+ */
+static void setGlints(FrameResult& frameResult, const vector<cv::Point>& glints,
+        const Point2f& glintCenter, const Point& origin) {
+    frameResult.glints.clear();
+    for (unsigned int i = 0; i < glints.size(); ++i)
+        frameResult.glints.push_back(glints[i] + origin);
+    frameResult.glintCenter = glintCenter + Point2f(origin.x, origin.y);
+}
+
+GazeTracker::GazeTracker(ImageSource & imageSource, TrackerCallback *callback,
+        const TrackerConfig &config) :
+imageSrc(imageSource), config(config), glintFinder(config), starburst(config),
+tracker_callback(callback), gazeFilter(&defaultFilter), qualityController(NULL),
+hasGazeVector(false), isRunning(false),
+eyeFinder(glintFinder, config), eyeWorker(config), noGlints(0), lostFrames(0),
+eyeSearches(0), templateFrames(0), droppedFrames(0), pipelined(false), pendingDroppedFrames(0),
+glintQueue(NULL), pupilQueue(NULL), binocular(false), synchronousEyeSearch(false) {
 }
 
 void GazeTracker::getNextFrame(Mat& frame) {
-    bool hasImage = imageSrc.nextGrayFrame(frame);
+    bool hasImage;
+    {
+        ScopedTimer timer(STAGE_GRAB_FRAME);
+        hasImage = imageSrc.nextGrayFrame(frame);
+    }
     if (!hasImage) {
         LOG_W("No image");
         throw NoImageSourceException();
     }
+
+    // a gap in the sequence numbers means that the source dropped frames
+    unsigned long lastSequenceNumber = frameInfo.sequenceNumber;
+    frameInfo = imageSrc.lastFrameInfo();
+
+    if (lastSequenceNumber > 0 && frameInfo.sequenceNumber > lastSequenceNumber + 1) {
+        unsigned long dropped = frameInfo.sequenceNumber - lastSequenceNumber - 1;
+        droppedFrames += dropped;
+
+        LOG_D("Dropped frames: " << dropped);
+        if (pipelined)
+            pendingDroppedFrames += dropped; // reported by the thread calling track()
+        else if (tracker_callback != NULL)
+            tracker_callback->framesDropped(dropped, frameInfo.sequenceNumber);
+    }
+}
+
+void GazeTracker::updateRegionOfInterest() {
+    // the eyeWorker needs the full frame
+    if (lostFrames > 0 && !eyeWorker.isBusy()) {
+        imageSrc.setRegionOfInterest(Rect());
+        return;
+    }
+
+    // the source only needs to deliver the largest window the next frame
+    // may be searched in. it clips the window to the frame itself
+    if (lostFrames > 0 && !binocular) {
+        // the lost glints are searched in a window which does not move
+        imageSrc.setRegionOfInterest(lostEyeWindow());
+        return;
+    }
+
+    // the RegionPredictor keeps a region between REGION_MIN_SCALE_PERCENT
+    // and REGION_MAX_SCALE_PERCENT of the eye, the next region may grow from
+    // the smallest to the largest size. the margin covers the movement of
+    // its center
+    const int margin = GazeConfig::REGION_OF_INTEREST_MARGIN;
+    int growX = frameRegion.width * (GazeConfig::REGION_MAX_SCALE_PERCENT
+            - GazeConfig::REGION_MIN_SCALE_PERCENT) / GazeConfig::REGION_MIN_SCALE_PERCENT / 2;
+    int growY = frameRegion.height * (GazeConfig::REGION_MAX_SCALE_PERCENT
+            - GazeConfig::REGION_MIN_SCALE_PERCENT) / GazeConfig::REGION_MIN_SCALE_PERCENT / 2;
+    imageSrc.setRegionOfInterest(Rect(frameRegion.x - growX - margin,
+            frameRegion.y - growY - margin, frameRegion.width + 2 * (growX + margin),
+            frameRegion.height + 2 * (growY + margin)));
 }
 
+unsigned long GazeTracker::getDroppedFrames() const {
+    return droppedFrames;
+}
+
+void GazeTracker::setConfig(const TrackerConfig &config) {
+    // the only step which may fail, the tracker is unchanged then
+    eyeFinder.setConfig(config);
+    this->config = config;
+    glintFinder.setConfig(config);
+    starburst.setConfig(qualityConfig());
+    eyeWorker.setConfig(config);
+}
+
+const TrackerConfig& GazeTracker::getConfig() const {
+    return config;
+}
+
+/**
+ * asks the ImageSource for full frames again when it goes out of scope,
+ * also if the tracking ends with an exception. other clients of the source
+ * (e.g. a preview) expect full frames
+ */
+class FullFrameGuard {
+private:
+    ImageSource& source;
+
+    FullFrameGuard(const FullFrameGuard&);
+    FullFrameGuard& operator=(const FullFrameGuard&);
+public:
+
+    FullFrameGuard(ImageSource& source) : source(source) {
+    }
+
+    ~FullFrameGuard() {
+        source.setRegionOfInterest(Rect());
+    }
+};
+
 void GazeTracker::initializeCalibration() {
+    FullFrameGuard fullFrames(imageSrc);
     Mat frame;
     // Copy for displaying image
     Mat fullFrame;
@@ -42,6 +177,14 @@ void GazeTracker::initializeCalibration() {
 bool GazeTracker::findEyeRegion(Mat & frame,
         Point2f& frameCenter, bool calibrationMode) {
 
+    // the haar classifier needs the full frame
+    lostFrames = 0;
+    noGlints = 0;
+    templateFrames = 0;
+    eyeTemplate.reset();
+    eyeWorker.cancel();
+    imageSrc.setRegionOfInterest(Rect());
+
     bool foundEye = false;
     short tries = 0;
     while (!foundEye) {
@@ -61,43 +204,338 @@ bool GazeTracker::findEyeRegion(Mat & frame,
         }
 
         // No eye region found
-        if (!calibrationMode && tries > GazeConfig::HAAR_FINDREGION_MAX_TRIES)
+        if (!calibrationMode && tries > config.haarFindRegionMaxTries)
             throw EyeRegionNotFoundException();
         
     }
 
     frameCenter = calcRectBarycenter(frameRegion);
     frame = frame(frameRegion);
+
+    // frameRegion is kept in full frame coordinates. a frame captured 
+    // before the region of interest was cleared may still be a window
+    frameRegion += frameInfo.region.tl();
+    regionPredictor.reset(frameRegion, frameInfo.sequenceNumber);
+    updateRegionOfInterest();
+
+    eyeSize = frameRegion.size();
+    lastGlintCenter = calcRectBarycenter(frameRegion);
     
     // continue the processing
     return true;
 }
 
-void GazeTracker::adjustRect(cv::Point2f& currentCenter, cv::Rect& frameRegion) {
-    int width = frameRegion.width;
-    int height = frameRegion.height;
+/**
+ * moves the frameRegion to the eye region of the next frame. while the eye
+ * is lost the frame is handed to the eyeWorker and the glints are searched
+ * in a growing window around their last position
+ * @param frame the next frame as delivered by the ImageSource
+ * @param glintCenter the glint center in the eye region (where the glints
+ *  are searched first), moved with the region
+ * @return true if the eyeWorker has found the eye region
+ */
+bool GazeTracker::nextFrameRegion(const Mat& frame, Point2f& glintCenter) {
+    if (lostFrames == 0) {
+        frameRegion = regionPredictor.predict(frameInfo.sequenceNumber);
+        return false;
+    }
+
+    Rect regions[NUM_OF_EYES];
+    if (pollLostEye(frame, false, regions) == EYE_SEARCH_FOUND) {
+        LOG_D("Eye region found: " << regions[LEFT_EYE]);
+        lastGlintCenter = calcRectBarycenter(regions[LEFT_EYE]);
+        eyeTemplate.reset();
+        restartEyeRegion(regions[LEFT_EYE], glintCenter);
+        return true;
+    }
+
+    frameRegion = lostEyeWindow();
+    glintCenter = lastGlintCenter - Point2f(frameRegion.x, frameRegion.y);
+    ++lostFrames;
+    return false;
+}
+
+/**
+ * most glints are lost by a blink or a small head move. the FindGlints 
+ * finds them again in a window around their last position long before the
+ * haar classifiers are done
+ * @return the window in which the lost glints are searched, it grows with
+ *  the number of frames since they have been lost
+ */
+Rect GazeTracker::lostEyeWindow() const {
+    int stage = min((lostFrames - 1) / REACQUIRE_FRAMES_PER_STAGE,
+            NUM_OF_REACQUIRE_STAGES - 1);
+    Size size(eyeSize.width * REACQUIRE_SCALE_PERCENT[stage] / 100,
+            eyeSize.height * REACQUIRE_SCALE_PERCENT[stage] / 100);
+    Rect window(cvRound(lastGlintCenter.x - size.width / 2.f),
+            cvRound(lastGlintCenter.y - size.height / 2.f), size.width, size.height);
+
+    Rect fullFrame(Point(), frameInfo.resolution);
+    if (fullFrame.area() > 0)
+        window &= fullFrame;
+    return window;
+}
+
+/**
+ * hands the frame to the eyeWorker unless it is busy
+ * @param frame the frame as delivered by the ImageSource
+ * @param binocular true to search both eyes
+ */
+void GazeTracker::searchLostEye(const Mat& frame, bool binocular) {
+    // a frame requested before the eye was lost may still be a window
+    if (frameInfo.region.size() != frameInfo.resolution)
+        return;
+
+    // the worker starts around the eye pair found by the eyeFinder
+    eyeWorker.search(frame, frameInfo, binocular, eyeFinder.getSearchHint());
+}
+
+/**
+ * takes the result of the eyeWorker and hands it the frame for the next
+ * search. the synchronous eyeWorker searches the frame first, its result
+ * belongs to this frame
+ * @param frame the frame as delivered by the ImageSource
+ * @param binocular true to search both eyes
+ * @param regions the found eye region(s)
+ * @return the state of the search
+ * @throws EyeRegionNotFoundException if the eye has not been found in
+ *  TrackerConfig::haarFindRegionMaxTries frames
+ */
+EyeSearchState GazeTracker::pollLostEye(const Mat& frame, bool binocular,
+        Rect regions[NUM_OF_EYES]) {
+    if (synchronousEyeSearch)
+        searchLostEye(frame, binocular);
+
+    EyeSearchState state = eyeWorker.poll(regions);
+    if (state == EYE_SEARCH_NOT_FOUND && ++eyeSearches > config.haarFindRegionMaxTries)
+        throw EyeRegionNotFoundException();
+
+    if (!synchronousEyeSearch && state != EYE_SEARCH_FOUND)
+        searchLostEye(frame, binocular);
+    return state;
+}
+
+/**
+ * counts the frames without glints and starts the search of the eye region
+ * when there are too many. frames in which the eyeTemplate finds the eye
+ * are not counted. glints found while the eye is searched end the search, 
+ * the haar classifiers are not needed anymore
+ * @param eyeImage the frame cropped to the frameRegion
+ * @param result the result of the frame
+ * @param glintCenter the glint center in the eye region, moved if the 
+ *  glints have been found again
+ * @return true if the glints have been found again
+ */
+bool GazeTracker::followGlints(const Mat& eyeImage, MeasureResult result,
+        Point2f& glintCenter) {
+    if (result == FINDGLINT_FAILED) {
+        if (lostFrames == 0 && followEyeTemplate(eyeImage))
+            return false;
+
+        if (lostFrames == 0 && ++noGlints > MAX_FRAMES_WITHOUT_GLINTS) {
+            LOG_W("no glints found. need to reinitialize");
+            lostFrames = 1;
+            eyeSearches = 0;
+        }
+        return false;
+    }
+
+    // the eye with its glints is the template for the next hidden glints
+    templateFrames = 0;
+    eyeTemplate.update(eyeImage, lastGlintCenter - Point2f(frameRegion.x, frameRegion.y),
+            Size(eyeSize.width * EYE_TEMPLATE_SIZE_PERCENT / 100,
+            eyeSize.height * EYE_TEMPLATE_SIZE_PERCENT / 100));
+
+    if (lostFrames == 0)
+        return false;
+
+    LOG_D("Glints found again after " << lostFrames << " frames");
+    eyeWorker.cancel();
+    restartEyeRegion(Rect(cvRound(lastGlintCenter.x - eyeSize.width / 2.f),
+            cvRound(lastGlintCenter.y - eyeSize.height / 2.f),
+            eyeSize.width, eyeSize.height), glintCenter);
+    return true;
+}
+
+/**
+ * searches the eyeTemplate in the eye region of a frame without glints. a
+ * partial blink or a reflection hides the glints, but the eye is still 
+ * there: the region follows the template instead of the glints
+ * @param eyeImage the frame cropped to the frameRegion
+ * @return true if the eye has been found, the frame does not count as a
+ *  frame without glints
+ */
+bool GazeTracker::followEyeTemplate(const Mat& eyeImage) {
+    if (templateFrames >= MAX_FRAMES_ON_TEMPLATE)
+        return false;
 
-    int x = frameRegion.x + currentCenter.x - (width / 2);
-    int y = frameRegion.y + currentCenter.y - (height / 2);
+    Point2f glintCenter;
+    if (!eyeTemplate.relocate(eyeImage, glintCenter))
+        return false;
 
-    // Range check
-    x = (x > 0) ? x : 0;
-    y = (y > 0) ? y : 0;
+    ++templateFrames;
+    lastGlintCenter = glintCenter + Point2f(frameRegion.x, frameRegion.y);
+    regionPredictor.correct(lastGlintCenter);
+    return true;
+}
 
-    frameRegion.x = x;
-    frameRegion.y = y;
+/**
+ * restarts the tracking in the given eye region
+ * @param region the eye region (full frame coordinates)
+ * @param glintCenter the last glint center in the eye region
+ */
+void GazeTracker::restartEyeRegion(const Rect& region, Point2f& glintCenter) {
+    frameRegion = region;
+    regionPredictor.reset(region, frameInfo.sequenceNumber);
+    eyeSize = region.size();
+    glintCenter = lastGlintCenter - Point2f(region.x, region.y);
 
+    lostFrames = 0;
+    noGlints = 0;
 }
 
 GazeTracker::~GazeTracker() {
     // TODO Auto-generated destructor stub
 }
 
+void GazeTracker::setPipelined(bool pipelined) {
+    this->pipelined = pipelined;
+}
+
+void GazeTracker::setGazeFilter(GazeFilter *filter) {
+    gazeFilter = (filter != NULL) ? filter : &defaultFilter;
+    gazeFilter->reset();
+}
+
+void GazeTracker::restartSmoothing() {
+    gazeFilter->reset();
+    hasGazeVector = false;
+}
+
+void GazeTracker::setQualityController(QualityController *controller) {
+    qualityController = controller;
+    if (qualityController != NULL)
+        qualityController->reset();
+    starburst.setConfig(qualityConfig());
+}
+
+/**
+ * @return the config of the pupil search with the current quality
+ */
+TrackerConfig GazeTracker::qualityConfig() const {
+    if (qualityController == NULL)
+        return config;
+    return qualityController->apply(config);
+}
+
+/**
+ * feeds the processing time of a frame into the QualityController and hands
+ * a new quality to the starburst. frames without glints are not counted, 
+ * the pupil search has not run
+ * @param startTick when the processing of the frame has started
+ * @param frameResult the frame, gets the quality it has been measured with
+ * @return true if the quality has changed
+ */
+bool GazeTracker::adaptQuality(int64 startTick, FrameResult& frameResult) {
+    if (qualityController == NULL)
+        return false;
+
+    frameResult.qualityPercent = qualityController->qualityPercent();
+    if (frameResult.result == FINDGLINT_FAILED)
+        return false;
+
+    double micros = (getTickCount() - startTick) * 1e6 / getTickFrequency();
+    if (!qualityController->update(micros))
+        return false;
+
+    LOG_D("Quality: " << qualityController->qualityPercent() << "%");
+    starburst.setConfig(qualityConfig());
+    return true;
+}
+
+void GazeTracker::setBinocular(bool binocular) {
+    this->binocular = binocular;
+}
+
+void GazeTracker::setSynchronousEyeSearch(bool synchronous) {
+    this->synchronousEyeSearch = synchronous;
+    eyeWorker.setSynchronous(synchronous);
+}
+
 void GazeTracker::track(unsigned int duration) {
+    FullFrameGuard fullFrames(imageSrc);
+
+    if (binocular)
+        trackBinocular(duration);
+    else if (pipelined)
+        trackPipelined(duration);
+    else
+        trackSequential(duration);
+}
+
+void GazeTracker::cropToFrameRegion(Mat& frame) {
+    // the source may deliver only a window of the full frame
+    frame = cropToRegion(frame, frameInfo.region.tl(), frameRegion);
+}
+
+Mat GazeTracker::cropToRegion(const Mat& frame, const Point& offset, Rect& region) {
+    ScopedTimer timer(STAGE_CROP);
+    Rect window = region - offset;
+
+    // the region is moved back into the frame
+    if ((window.x + window.width) > frame.cols)
+        window.x = frame.cols - window.width;
+
+    if ((window.y + window.height) > frame.rows)
+        window.y = frame.rows - window.height;
+
+    window.x = (window.x > 0) ? window.x : 0;
+    window.y = (window.y > 0) ? window.y : 0;
+
+    // a region larger than the frame is clipped, the region describes the
+    // returned image
+    window &= Rect(Point(), frame.size());
+    region = window + offset;
+    return frame(window);
+}
+
+float GazeTracker::gazeConfidence(const Point2f& gazeVector, double glintDistance) {
+    double jump = hasGazeVector ? norm(gazeVector - lastGazeVector) : 0;
+    lastGazeVector = gazeVector;
+    hasGazeVector = true;
+
+    return jumpConfidence(jump, glintDistance);
+}
+
+bool GazeTracker::publishResult(FrameResult& frameResult, double glintDistance) {
+
+    LOG_D("Measure result: " << frameResult.result);
+
+    if (frameResult.result == MEASURE_OK) {
+        frameResult.gazeVector = gazeFilter->filter(frameResult.measuredGazeVector,
+                frameResult.frameInfo.captureTick / getTickFrequency());
+
+        // the binocular tracking has fused the confidences of the eyes
+        if (!frameResult.binocular)
+            frameResult.confidence = gazeConfidence(frameResult.measuredGazeVector,
+                glintDistance);
+
+        LOG_D("Current GazeVector: " << frameResult.measuredGazeVector);
+    }
+
+    // notify our callback about the processed frames...
+    if (this->tracker_callback != NULL) {
+        ScopedTimer timer(STAGE_CALLBACK);
+        return tracker_callback->frameProcessed(frameResult);
+    }
+
+    return true;
+}
+
+void GazeTracker::trackSequential(unsigned int duration) {
 
     Mat currentFrame;
     Point2f glintCenter;
-    Point2f gazeVector;
 
     double ticks = 0;
     double maxTicks = 0;
@@ -107,123 +545,646 @@ void GazeTracker::track(unsigned int duration) {
     // Find eye 
     findEyeRegion(currentFrame, glintCenter);
 
-    int noGlints = 0;
-
     double startTick = getTickCount();
 
     bool continueTracking = true;
     
     // main loop
     do {
-        // Get next frame
-        getNextFrame(currentFrame);
+        FrameResult frameResult;
+        bool restarted;
+        {
+            FrameTimingScope timingScope(frameResult.timings);
+
+            // Get next frame
+            getNextFrame(currentFrame);
+            int64 workTick = getTickCount();
 #if __DEBUG_HAAR == 1
-        Mat f1 = currentFrame.clone();
+            Mat f1 = currentFrame.clone();
 
-        rectangle(f1, frameRegion, Scalar(255, 255, 255), 3);
-        imshow("Frame from source", f1);
+            rectangle(f1, frameRegion, Scalar(255, 255, 255), 3);
+            imshow("Frame from source", f1);
 
 #endif     
 
-        if ((frameRegion.x + frameRegion.width) > currentFrame.cols)
-            frameRegion.x = currentFrame.cols - frameRegion.width;
+            restarted = nextFrameRegion(currentFrame, glintCenter);
+            cropToFrameRegion(currentFrame);
+            frameResult.image = currentFrame;
+            frameResult.region = frameRegion;
+            frameResult.frameInfo = frameInfo;
 
-        if ((frameRegion.y + frameRegion.height) > currentFrame.rows)
-            frameRegion.y = currentFrame.rows - frameRegion.height;
+            MeasureResult result = measureFrame(currentFrame, glintCenter, frameResult);
+            restarted = followGlints(currentFrame, result, glintCenter) || restarted;
+            updateRegionOfInterest();
+            adaptQuality(workTick, frameResult);
+        }
+
+        if (restarted)
+            restartSmoothing();
 
-        currentFrame = currentFrame(frameRegion);
+        continueTracking = publishResult(frameResult, glintFinder.getGlintDistance());
 
-        MeasureResult result = measureFrame(currentFrame, gazeVector, glintCenter);
+        ticks = getTickCount() - startTick;
         
-        LOG_D("Measure result: " << result);
+    } while (continueTracking && (maxTicks == 0 || ticks < maxTicks));
+}
 
-        Point2f smoothed_gaze_vec;
-        switch (result) {
-            case MEASURE_OK:
+/**
+ * runs one stage of the pipelined tracking on its own thread. exceptions
+ * cannot cross threads, so they are remembered and rethrown by the thread
+ * calling track()
+ */
+class PipelineStage : public Thread {
+private:
+    enum StageError {
+        STAGE_OK,
+        STAGE_EYE_REGION_NOT_FOUND,
+        STAGE_NO_IMAGE_SOURCE,
+        STAGE_FAILED,
+    };
 
-                this->smoothSignal(gazeVector, smoothed_gaze_vec,
-                        this->last_gaze_vectors, framenumber);
+    GazeTracker& tracker;
+    void (GazeTracker::*stage)();
+    StageError error;
+    std::string errorMsg;
 
-                LOG_D("Current GazeVector: " << gazeVector);
+protected:
 
-                ++framenumber;
-                break;
+    void run() {
+        try {
+            (tracker.*stage)();
+        } catch (EyeRegionNotFoundException &e) {
+            error = STAGE_EYE_REGION_NOT_FOUND;
+        } catch (NoImageSourceException &e) {
+            error = STAGE_NO_IMAGE_SOURCE;
+        } catch (std::exception &e) {
+            // e.g. a cv::Exception or bad_alloc, it must not end the process
+            // but reach the thread calling track() like any other error
+            error = STAGE_FAILED;
+            errorMsg = e.what();
+        }
+
+        // wake up the other stages, the pipeline is done
+        if (error != STAGE_OK) {
+            tracker.glintQueue->close();
+            tracker.pupilQueue->close();
+        }
+    }
 
-            case FINDGLINT_FAILED:
-                noGlints++;
-                if (noGlints > 20) { //TODO should be a constant
-                    LOG_W("no glints found. need to reinitialize");
-                    findEyeRegion(currentFrame, glintCenter);
+public:
 
-                    noGlints = 0;
-                    framenumber = 0; // restart the smoothing
-                }
+    PipelineStage(GazeTracker& tracker, void (GazeTracker::*stage)()) :
+    tracker(tracker), stage(stage), error(STAGE_OK) {
+    }
+
+    ~PipelineStage() {
+        tracker.glintQueue->close();
+        tracker.pupilQueue->close();
+        join();
+    }
+
+    /**
+     * throws the exception which has stopped this stage (if any)
+     */
+    void rethrow() const {
+        switch (error) {
+            case STAGE_EYE_REGION_NOT_FOUND:
+                throw EyeRegionNotFoundException();
+            case STAGE_NO_IMAGE_SOURCE:
+                throw NoImageSourceException();
+            case STAGE_FAILED:
+                throw GazeException(errorMsg);
+            case STAGE_OK:
                 break;
+        }
+    }
+};
+
+void GazeTracker::trackPipelined(unsigned int duration) {
+
+    double maxTicks = 0;
+    if (duration > 0)
+        maxTicks = duration * getTickFrequency();
 
-            case FINDPUPIL_FAILED:
-                //TODO
+    SpscQueue<PipelineFrame> glints(GazeConfig::PIPELINE_QUEUE_SIZE);
+    SpscQueue<PipelineFrame> pupils(GazeConfig::PIPELINE_QUEUE_SIZE);
+    glintQueue = &glints;
+    pupilQueue = &pupils;
+
+    {
+        // the destructors stop and join the stages, even if the callback throws
+        PipelineStage glintThread(*this, &GazeTracker::glintStage);
+        PipelineStage pupilThread(*this, &GazeTracker::pupilStage);
+        glintThread.start();
+        pupilThread.start();
+
+        // the eye region is searched by the glint stage, the duration starts
+        // with the first tracked frame
+        double startTick = 0;
+        bool continueTracking = true;
+        PipelineFrame tracked;
+
+        while (continueTracking && pupils.pop(tracked)) {
+            if (startTick == 0)
+                startTick = getTickCount();
+
+            if (tracked.restarted)
+                restartSmoothing();
+
+            if (tracked.droppedFrames > 0 && tracker_callback != NULL)
+                tracker_callback->framesDropped(tracked.droppedFrames,
+                    tracked.measured.frameInfo.sequenceNumber);
+
+            continueTracking = publishResult(tracked.measured, tracked.glintDistance);
+
+            double ticks = getTickCount() - startTick;
+            continueTracking = continueTracking && (maxTicks == 0 || ticks < maxTicks);
+        }
+
+        pupils.close();
+        glints.close();
+        glintThread.join();
+        pupilThread.join();
+
+        glintThread.rethrow();
+        pupilThread.rethrow();
+    }
+
+    glintQueue = NULL;
+    pupilQueue = NULL;
+}
+
+void GazeTracker::glintStage() {
+    Mat currentFrame;
+    Point2f glintCenter;
+
+    pendingDroppedFrames = 0;
+    findEyeRegion(currentFrame, glintCenter);
+
+    while (true) {
+        PipelineFrame tracked;
+        {
+            FrameTimingScope timingScope(tracked.measured.timings);
+
+            getNextFrame(currentFrame);
+            tracked.restarted = nextFrameRegion(currentFrame, glintCenter);
+            cropToFrameRegion(currentFrame);
+
+            tracked.measured.image = currentFrame;
+            tracked.measured.region = frameRegion;
+            tracked.measured.frameInfo = frameInfo;
+            tracked.droppedFrames = pendingDroppedFrames;
+            pendingDroppedFrames = 0;
+
+            // like measureFrame(), every frame starts the search at the glint 
+            // center found with the eye region
+            tracked.glintCenter = glintCenter;
+            if (glintFinder.findGlints(currentFrame, tracked.glints, tracked.glintCenter)) {
+                setGlints(tracked.measured, tracked.glints, tracked.glintCenter,
+                        frameRegion.tl());
+                regionPredictor.correct(tracked.measured.glintCenter);
+                lastGlintCenter = tracked.measured.glintCenter;
+            } else {
+                tracked.measured.result = FINDGLINT_FAILED;
+            }
+            tracked.restarted = followGlints(currentFrame, tracked.measured.result, glintCenter)
+                    || tracked.restarted;
+            tracked.glintDistance = glintFinder.getGlintDistance();
+            updateRegionOfInterest();
+        }
+
+        if (!glintQueue->push(tracked))
+            break; // the tracking has been stopped
+    }
+}
+
+void GazeTracker::pupilStage() {
+    PipelineFrame tracked;
+
+    while (glintQueue->pop(tracked)) {
+        // the pupil stage has to keep up with the frame rate on its own
+        int64 workTick = getTickCount();
+        if (tracked.measured.result == MEASURE_OK) {
+            FrameTimingScope timingScope(tracked.measured.timings);
+            measurePupil(tracked.measured.image, tracked.glints,
+                    tracked.glintCenter, tracked.measured);
+        }
+        adaptQuality(workTick, tracked.measured);
+
+        if (!pupilQueue->push(tracked))
+            break; // the tracking has been stopped
+    }
+
+    // no more frames
+    pupilQueue->close();
+    glintQueue->close();
+}
+
+void GazeTracker::findEyeRegions(Mat& frame, Rect eyeRegions[NUM_OF_EYES]) {
+
+    // the haar classifier needs the full frame
+    lostFrames = 0;
+    eyeWorker.cancel();
+    imageSrc.setRegionOfInterest(Rect());
+
+    short tries = 0;
+    while (true) {
+        getNextFrame(frame);
+
+        if (eyeFinder.findEyes(frame, eyeRegions[LEFT_EYE], eyeRegions[RIGHT_EYE]))
+            break;
+
+        // No eye region found
+        if (++tries > config.haarFindRegionMaxTries)
+            throw EyeRegionNotFoundException();
+    }
+
+    // like findEyeRegion() the regions are kept in full frame coordinates
+    for (int eye = 0; eye < NUM_OF_EYES; ++eye)
+        eyeRegions[eye] += frameInfo.region.tl();
+
+    frameRegion = eyeRegions[LEFT_EYE] | eyeRegions[RIGHT_EYE];
+    updateRegionOfInterest();
+}
+
+/**
+ * tracks one eye in the binocular tracking. every eye has its own FindGlints
+ * and Starburst, so both eyes can be measured at the same time
+ */
+class EyeChannel {
+private:
+    FindGlints glintFinder;
+    Starburst starburst;
+    RegionPredictor regionPredictor;
+    /// the size of the eye found by the haar classifier
+    Size eyeSize;
+    /// the last GazeVector of this eye, if hasGazeVector
+    Point2f lastGazeVector;
+    bool hasGazeVector;
+
+public:
+    /// the last measurement. the glint center is kept while the glints are
+    /// lost, the other eye may follow it
+    EyeMeasurement measurement;
+    /// the number of frames since the glints have been found
+    int noGlints;
+
+    EyeChannel(GazeTracker& tracker) :
+    glintFinder(tracker.config), starburst(tracker.qualityConfig()),
+    hasGazeVector(false), noGlints(0) {
+    }
+
+    /**
+     * changes the quality of the pupil search
+     * @param config the config with the new quality
+     */
+    void setPupilConfig(const TrackerConfig& config) {
+        starburst.setConfig(config);
+    }
+
+    /**
+     * starts tracking the eye in the region found by the haar classifier
+     */
+    void restart(const Rect& region, unsigned long sequenceNumber) {
+        eyeSize = region.size();
+        measurement.region = region;
+        regionPredictor.reset(region, sequenceNumber);
+        hasGazeVector = false;
+        noGlints = 0;
+    }
+
+    /**
+     * searches the glints of the eye at the given position again
+     */
+    void follow(const Point2f& center, unsigned long sequenceNumber) {
+        Rect region(cvRound(center.x - eyeSize.width / 2.f),
+                cvRound(center.y - eyeSize.height / 2.f), eyeSize.width, eyeSize.height);
+        measurement.region = region;
+        regionPredictor.reset(region, sequenceNumber);
+        hasGazeVector = false;
+        noGlints = 0;
+    }
+
+    /**
+     * measures the eye in its predicted region
+     * @param frame the frame (or the window of the frame) from the source
+     * @param offset the position of the window in the full frame
+     * @param sequenceNumber the sequence number of the frame
+     */
+    void measure(const Mat& frame, const Point& offset, unsigned long sequenceNumber) {
+        measurement.region = regionPredictor.predict(sequenceNumber);
+        Mat eyeFrame = GazeTracker::cropToRegion(frame, offset, measurement.region);
+        Point2f origin(measurement.region.x, measurement.region.y);
+
+        vector<cv::Point> glints;
+        Point2f center;
+        Point2f pupil;
+        measurement.confidence = 0;
+        measurement.glints.clear();
+
+        if (!glintFinder.findGlints(eyeFrame, glints, center)) {
+            measurement.result = FINDGLINT_FAILED;
+            ++noGlints;
+            return;
+        }
+        noGlints = 0;
+        for (unsigned int i = 0; i < glints.size(); ++i)
+            measurement.glints.push_back(glints[i] + measurement.region.tl());
+        measurement.glintCenter = center + origin;
+        regionPredictor.correct(measurement.glintCenter);
+
+        if (!starburst.findPupil(eyeFrame, glints, center, pupil, measurement.pupilRadius)) {
+            measurement.result = FINDPUPIL_FAILED;
+            return;
+        }
+        measurement.pupilCenter = pupil + origin;
+
+        measurement.result = MEASURE_OK;
+        measurement.gazeVector = center - pupil;
+
+        double jump = hasGazeVector ? norm(measurement.gazeVector - lastGazeVector) : 0;
+        measurement.confidence = jumpConfidence(jump, glintFinder.getGlintDistance());
+        lastGazeVector = measurement.gazeVector;
+        hasGazeVector = true;
+    }
+};
+
+/**
+ * measures an eye on its own thread. measure() hands over a frame and 
+ * wait() blocks until the eye has been measured
+ */
+class EyeWorker : public Thread {
+private:
+    struct EyeFrame {
+        Mat frame;
+        Point offset;
+        unsigned long sequenceNumber;
+    };
+
+    EyeChannel& eye;
+    SpscQueue<EyeFrame> frames;
+    SpscQueue<bool> measured;
+    bool failed;
+    std::string errorMsg;
+    FrameTimings timings;
+
+protected:
+
+    void run() {
+        EyeFrame next;
+        while (frames.pop(next)) {
+            timings.reset();
+            try {
+                FrameTimingScope timingScope(timings);
+                eye.measure(next.frame, next.offset, next.sequenceNumber);
+            } catch (std::exception &e) {
+                // wait() throws it on the thread calling track()
+                failed = true;
+                errorMsg = e.what();
+            }
+
+            if (!measured.push(true))
                 break;
         }
+        measured.close();
+    }
+
+public:
 
-        // notify our callback about the processed frames...
-        if (this->tracker_callback != NULL)
-            continueTracking = tracker_callback->imageProcessed(currentFrame, result, smoothed_gaze_vec);
+    EyeWorker(EyeChannel& eye) : eye(eye), frames(1), measured(1), failed(false) {
+    }
+
+    ~EyeWorker() {
+        frames.close();
+        measured.close();
+        join();
+    }
+
+    void measure(const Mat& frame, const Point& offset, unsigned long sequenceNumber) {
+        EyeFrame next;
+        next.frame = frame;
+        next.offset = offset;
+        next.sequenceNumber = sequenceNumber;
+        frames.push(next);
+    }
+
+    /**
+     * @throws GazeException if the eye could not be measured
+     */
+    void wait() {
+        bool done;
+        if (!measured.pop(done))
+            throw GazeException("The eye worker has stopped");
+        if (failed)
+            throw GazeException(errorMsg);
+    }
+
+    /**
+     * @return the durations of the stages while measuring the last frame
+     */
+    const FrameTimings& getTimings() const {
+        return timings;
+    }
+};
+
+/**
+ * fuses the GazeVectors of both eyes, weighted with their confidence. the 
+ * GazeVectors of the eyes differ by an almost constant bias. every eye is
+ * corrected by half of it, so the fused GazeVector does not jump when one
+ * eye is lost
+ */
+static MeasureResult fuseEyes(const EyeMeasurement eyes[NUM_OF_EYES],
+        Point2f& bias, bool& hasBias, Point2f& gazeVector) {
+    const EyeMeasurement& left = eyes[LEFT_EYE];
+    const EyeMeasurement& right = eyes[RIGHT_EYE];
+
+    if (left.result == MEASURE_OK && right.result == MEASURE_OK) {
+        Point2f difference = right.gazeVector - left.gazeVector;
+        if (hasBias)
+            bias = bias * (1 - EYE_BIAS_ADAPTION) + difference * EYE_BIAS_ADAPTION;
+        else
+            bias = difference;
+        hasBias = true;
+    }
+
+    float weight = 0;
+    gazeVector = Point2f();
+    if (left.result == MEASURE_OK) {
+        gazeVector += (left.gazeVector + bias * 0.5) * left.confidence;
+        weight += left.confidence;
+    }
+    if (right.result == MEASURE_OK) {
+        gazeVector += (right.gazeVector - bias * 0.5) * right.confidence;
+        weight += right.confidence;
+    }
+
+    if (weight > 0) {
+        gazeVector = gazeVector * (1.0 / weight);
+        return MEASURE_OK;
+    }
+
+    // no eye has been measured, report the eye which came further
+    if (left.result == FINDPUPIL_FAILED || right.result == FINDPUPIL_FAILED)
+        return FINDPUPIL_FAILED;
+    return FINDGLINT_FAILED;
+}
+
+void GazeTracker::trackBinocular(unsigned int duration) {
+
+    Mat currentFrame;
+
+    double ticks = 0;
+    double maxTicks = 0;
+    if (duration > 0)
+        maxTicks = duration * getTickFrequency();
+
+    EyeChannel left(*this);
+    EyeChannel right(*this);
+    EyeChannel *eyes[NUM_OF_EYES] = {&left, &right};
+
+    // Find eyes
+    Rect eyeRegions[NUM_OF_EYES];
+    findEyeRegions(currentFrame, eyeRegions);
+    for (int eye = 0; eye < NUM_OF_EYES; ++eye)
+        eyes[eye]->restart(eyeRegions[eye], frameInfo.sequenceNumber);
+
+    // the calling thread measures the left eye, the worker the right one
+    EyeWorker rightWorker(right);
+    rightWorker.start();
+
+    // learned while both eyes are measured: the bias between the GazeVectors
+    // and the offset between the glints of the eyes
+    Point2f bias;
+    bool bothMeasured = false;
+    Point2f glintOffset;
+
+    double startTick = getTickCount();
+
+    bool continueTracking = true;
+
+    // main loop
+    do {
+        FrameResult frameResult;
+        frameResult.binocular = true;
+        bool restarted = false;
+        {
+            FrameTimingScope timingScope(frameResult.timings);
+
+            // Get next frame
+            getNextFrame(currentFrame);
+            int64 workTick = getTickCount();
+            Point offset = frameInfo.region.tl();
+            frameResult.frameInfo = frameInfo;
+
+            // both eyes are lost, the eyeWorker searches them meanwhile
+            if (lostFrames > 0) {
+                if (pollLostEye(currentFrame, true, eyeRegions) == EYE_SEARCH_FOUND) {
+                    for (int eye = 0; eye < NUM_OF_EYES; ++eye)
+                        eyes[eye]->restart(eyeRegions[eye], frameInfo.sequenceNumber);
+                    lostFrames = 0;
+                    restarted = true;
+                } else {
+                    ++lostFrames;
+                }
+            }
+
+            rightWorker.measure(currentFrame, offset, frameInfo.sequenceNumber);
+            left.measure(currentFrame, offset, frameInfo.sequenceNumber);
+            rightWorker.wait();
+
+            frameResult.eyes[LEFT_EYE] = left.measurement;
+            frameResult.eyes[RIGHT_EYE] = right.measurement;
+            frameResult.result = fuseEyes(frameResult.eyes, bias, bothMeasured,
+                    frameResult.measuredGazeVector);
+            if (frameResult.result == MEASURE_OK) {
+                frameResult.frameInfo.measureTick = getTickCount();
+                frameResult.confidence = max(left.measurement.confidence,
+                        right.measurement.confidence);
+            }
+
+            // both eyes are measured at the same time, the slower one counts.
+            // the worker waits for the next frame, its starburst is free
+            if (adaptQuality(workTick, frameResult)) {
+                left.setPupilConfig(qualityConfig());
+                right.setPupilConfig(qualityConfig());
+            }
+
+            if (left.measurement.result == MEASURE_OK && right.measurement.result == MEASURE_OK)
+                glintOffset = right.measurement.glintCenter - left.measurement.glintCenter;
+
+            // an eye without glints follows the other eye
+            bool searchEyes = left.noGlints > MAX_FRAMES_WITHOUT_GLINTS 
+                    && right.noGlints > MAX_FRAMES_WITHOUT_GLINTS;
+            if (searchEyes && lostFrames == 0) {
+                LOG_W("no glints found. need to reinitialize");
+                lostFrames = 1;
+                eyeSearches = 0;
+            } else if (!searchEyes && lostFrames > 0) {
+                // an eye has found its glints again
+                eyeWorker.cancel();
+                lostFrames = 0;
+            }
+            if (!searchEyes && bothMeasured) {
+                if (left.noGlints > MAX_FRAMES_WITHOUT_GLINTS)
+                    left.follow(right.measurement.glintCenter - glintOffset,
+                        frameInfo.sequenceNumber);
+                if (right.noGlints > MAX_FRAMES_WITHOUT_GLINTS)
+                    right.follow(left.measurement.glintCenter + glintOffset,
+                        frameInfo.sequenceNumber);
+            }
+
+            // the result image shows both eyes
+            frameRegion = left.measurement.region | right.measurement.region;
+            frameResult.image = cropToRegion(currentFrame, offset, frameRegion);
+            frameResult.region = frameRegion;
+            updateRegionOfInterest();
+        }
+        frameResult.timings += rightWorker.getTimings();
+
+        if (restarted)
+            restartSmoothing();
+
+        if (tracker_callback != NULL)
+            tracker_callback->eyesMeasured(frameResult.eyes, frameResult.frameInfo);
+
+        continueTracking = publishResult(frameResult, 0);
 
         ticks = getTickCount() - startTick;
-        
+
     } while (continueTracking && (maxTicks == 0 || ticks < maxTicks));
 }
 
-MeasureResult GazeTracker::measureFrame(Mat &frame, Point2f &gazeVector, Point2f glintCenter) {
+MeasureResult GazeTracker::measureFrame(Mat &frame, Point2f glintCenter,
+        FrameResult &frameResult) {
     vector<cv::Point> glints;
-    float radius;
-    Point2f pupilCenter;
 
-    if (glintFinder.findGlints(frame, glints, glintCenter)) {
+    if (!glintFinder.findGlints(frame, glints, glintCenter))
+        return frameResult.result = FINDGLINT_FAILED;
 
-        
-        
-        if (!starburst.findPupil(frame, glints, glintCenter,
-                pupilCenter, radius)) {
-            cross(frame, glintCenter, 10);
-            return FINDPUPIL_FAILED;
-        } else {
-            cross(frame, glintCenter, 10);
-        }
+    // the region follows the glints
+    setGlints(frameResult, glints, glintCenter, frameResult.region.tl());
+    regionPredictor.correct(frameResult.glintCenter);
+    lastGlintCenter = frameResult.glintCenter;
 
-        adjustRect(glintCenter, frameRegion);
+    return measurePupil(frame, glints, glintCenter, frameResult);
+}
 
-    } else {
-        return FINDGLINT_FAILED;
-    }
+MeasureResult GazeTracker::measurePupil(Mat &frame, vector<cv::Point> &glints,
+        Point2f glintCenter, FrameResult &frameResult) {
+    float radius;
+    Point2f pupilCenter;
+
+    if (!starburst.findPupil(frame, glints, glintCenter, pupilCenter, radius))
+        return frameResult.result = FINDPUPIL_FAILED;
 
-    circle(frame, pupilCenter, radius, Scalar(255, 255, 255));
-    cross(frame, pupilCenter, 5);
+    Point2f origin(frameResult.region.x, frameResult.region.y);
+    frameResult.pupilCenter = pupilCenter + origin;
+    frameResult.pupilRadius = radius;
 
     // now calculate the gaze vector
-    gazeVector.x = glintCenter.x - pupilCenter.x;
-    gazeVector.y = glintCenter.y - pupilCenter.y;
-
-    return MEASURE_OK;
-}
-
-void GazeTracker::smoothSignal(Point2f &measured, Point2f &smoothed, Point2f data[],
-        unsigned int framenumber) {
-    if (framenumber < GazeConfig::NUM_OF_SMOOTHING_FRAMES) {
-        // nothing to smooth here
-        smoothed.x = measured.x;
-        smoothed.y = measured.y;
-    } else {
-        smoothed.x = 0;
-        smoothed.y = 0;
-        for (unsigned short i = 0; i < GazeConfig::NUM_OF_SMOOTHING_FRAMES;
-                ++i) {
-            smoothed.x += data[i].x;
-            smoothed.y += data[i].y;
-        }
-        smoothed.x /= GazeConfig::NUM_OF_SMOOTHING_FRAMES;
-        smoothed.y /= GazeConfig::NUM_OF_SMOOTHING_FRAMES;
-    }
-    data[framenumber % GazeConfig::NUM_OF_SMOOTHING_FRAMES] = measured;
+    frameResult.measuredGazeVector.x = glintCenter.x - pupilCenter.x;
+    frameResult.measuredGazeVector.y = glintCenter.y - pupilCenter.y;
+    frameResult.frameInfo.measureTick = getTickCount();
 
+    return frameResult.result = MEASURE_OK;
 }
@@ -21,21 +21,21 @@
 #include "opencv2/core/core.hpp"
 
 #include "../video/ImageSource.hpp"
+#include "../video/FrameInfo.hpp"
 #include "../detection/eye/FindEyeRegion.hpp"
+#include "../detection/eye/EyeRegionWorker.hpp"
+#include "../detection/eye/EyeTemplateTracker.hpp"
 #include "../detection/glint/FindGlints.hpp"
 #include "../detection/pupil/Starburst.hpp"
+#include "../detection/RegionPredictor.hpp"
+#include "../detection/FrameResult.hpp"
+#include "../detection/QualityController.hpp"
 #include "../calibration/Calibration.hpp"
+#include "../utils/SpscQueue.hpp"
+#include "../filter/GazeFilter.hpp"
 
 #include "../config/GazeConfig.hpp"
-
-/**
- * the result of each measure
- */
-enum MeasureResult {
-    MEASURE_OK,
-    FINDPUPIL_FAILED,
-    FINDGLINT_FAILED,
-};
+#include "../config/TrackerConfig.hpp"
 
 /**
  * Clients of the GazeLib need to implement this interface to get measure 
@@ -74,6 +74,68 @@ public:
      *  stop
      */
     virtual bool imageProcessed(Mat &resultImage, MeasureResult &result, Point2f &gazeVector) = 0;
+
+    /**
+     * the default frameProcessed() calls this variant of imageProcessed(Mat, MeasureResult, Point2f)
+     * for each processed frame. in addition it gets the FrameInfo of the 
+     * processed frame, which allows measuring the latency between capturing
+     * the frame and using the GazeVector.
+     * <br/>the default implementation just calls imageProcessed(Mat, MeasureResult, Point2f)
+     * 
+     * @param resultImage the processed image
+     * @param result whether the last image could be processed
+     * @param gazeVector the measured GazeVector if result==MEASURE_OK
+     * @param frameInfo the capture time, sequence number and resolution of the
+     *  frame. the measure time is set if result==MEASURE_OK
+     * @return true if the tracking should continue. false if the GazeLib should
+     *  stop
+     */
+    virtual bool imageProcessed(Mat &resultImage, MeasureResult &result, 
+            Point2f &gazeVector, const FrameInfo &frameInfo) {
+        return imageProcessed(resultImage, result, gazeVector);
+    }
+
+    /**
+     * the GazeTracker calls frameProcessed() for each measured frame. the
+     * FrameResult holds the GazeVector and everything the tracker has found
+     * in the frame. clients which do not display the frame should override
+     * this method, the overlay is only rendered if a client asks for it.
+     * <br/>the default implementation renders the overlay and calls 
+     * imageProcessed(Mat, MeasureResult, Point2f, FrameInfo)
+     * 
+     * @param frameResult the measurements of the frame
+     * @return true if the tracking should continue. false if the GazeLib should
+     *  stop
+     */
+    virtual bool frameProcessed(FrameResult &frameResult) {
+        Mat resultImage = frameResult.renderOverlay();
+        return imageProcessed(resultImage, frameResult.result, 
+                frameResult.gazeVector, frameResult.frameInfo);
+    }
+
+    /**
+     * framesDropped() is called before a frame is processed if the ImageSource
+     * has dropped frames since the last processed frame. this happens with 
+     * DELIVER_LATEST_FRAME if the processing is slower than the camera.
+     * <br/>the default implementation does nothing
+     * 
+     * @param numOfFrames the number of frames that were dropped
+     * @param sequenceNumber the sequence number of the frame processed next
+     */
+    virtual void framesDropped(unsigned long numOfFrames, unsigned long sequenceNumber) {
+    }
+
+    /**
+     * in the binocular tracking eyesMeasured() is called for each frame 
+     * before frameProcessed(), which gets the fused GazeVector of both eyes.
+     * <br/>the default implementation does nothing
+     * 
+     * @param eyes the measure results of the eyes, indexed by Eye
+     * @param frameInfo the capture time and sequence number of the frame
+     */
+    virtual void eyesMeasured(const EyeMeasurement eyes[NUM_OF_EYES], 
+            const FrameInfo &frameInfo) {
+    }
 };
 
 
@@ -89,47 +151,226 @@ public:
      * 
      * @param imageSource either a camera or a video source
      * @param callback the object that should be notified with the measure results
+     * @param config the tuning values of this tracker (defaults to the 
+     *  current values of the GazeConfig)
      */
-    GazeTracker(ImageSource & imageSource, TrackerCallback *callback = NULL);
+    GazeTracker(ImageSource & imageSource, TrackerCallback *callback = NULL,
+            const TrackerConfig &config = TrackerConfig());
     virtual ~GazeTracker();
 
     /**
      * tracks the pupil and glints and calculates the GazeVector. you can either track 
      * infinitely or during a defined timespan. the tracking aborts if the face 
      * is not found for a longer period.
+     * <br/>when the glints are lost the eye region is searched by the haar
+     * classifiers on another thread, the frames are still tracked (and 
+     * passed to the TrackerCallback) meanwhile.
+     * <br/>the TrackerCallback is always called on the thread calling track()
      * @param duration 0 or a tracking duration in seconds
      */
     void track(unsigned int duration=0);
+
+    /**
+     * switches the pipelined tracking on or off (default: off). 
+     * <br/>in the pipelined mode track() runs the frame grabbing, cropping
+     * and glint search on one thread and the pupil search on a second one.
+     * the smoothing and the TrackerCallback stay on the calling thread. the
+     * stages are connected by small queues, so each stage works on another
+     * frame at the same time and the frame rate is limited by the slowest
+     * stage instead of the sum of all stages. the results are still
+     * delivered in the order of the frames.
+     * <br/>wrap the ImageSource in a ThreadedSource to capture on its own thread too.
+     * @param pipelined true for the pipelined tracking
+     */
+    void setPipelined(bool pipelined);
+
+    /**
+     * switches the binocular tracking on or off (default: off).
+     * <br/>in the binocular mode track() searches both eyes in the eye pair
+     * and tracks each of them with its own FindGlints and Starburst. the 
+     * right eye is measured on a second thread while the calling thread 
+     * measures the left eye, so a frame takes about as long as with one eye.
+     * the GazeVectors of the eyes are fused with their confidence, the
+     * TrackerCallback gets the fused GazeVector and the single eyes with
+     * eyesMeasured().
+     * <br/>the tracking goes on as long as one eye is measured. an eye 
+     * without glints follows the other eye and both eyes are searched again
+     * if both have lost their glints.
+     * <br/>the binocular tracking is not pipelined, setPipelined() has no 
+     * effect while it is on.
+     * @param binocular true for the binocular tracking
+     */
+    void setBinocular(bool binocular);
+
+    /**
+     * switches the synchronous eye search on or off (default: off).
+     * <br/>while the eye is lost the haar classifiers usually run on a 
+     * thread of their own and the eye region is adopted on the frame on
+     * which they are done. with the synchronous search they run on the
+     * thread calling track() and the region is adopted on the frame it has
+     * been found in, so the results do not depend on the timing of the
+     * threads (e.g. for the BatchTracker, which runs a tracker per core).
+     * @param synchronous true for the synchronous eye search
+     */
+    void setSynchronousEyeSearch(bool synchronous);
+
+    /**
+     * replaces the filter which smooths the GazeVectors before they are 
+     * passed to the TrackerCallback. the default is a BoxFilter over the
+     * last GazeConfig::NUM_OF_SMOOTHING_FRAMES GazeVectors.
+     * <br/>the filter is used on the thread calling track(). the GazeTracker
+     * does not take the ownership, the filter must live as long as the
+     * tracker uses it.
+     * @param filter the new filter or NULL for the default filter
+     */
+    void setGazeFilter(GazeFilter *filter);
+
+    /**
+     * sets the QualityController which lowers the quality of the pupil 
+     * search while the frames take longer than its target frame period
+     * (default: none, always the full quality). the quality of each frame is
+     * reported in FrameResult::qualityPercent.
+     * <br/>the controller is reset and used on the thread searching the 
+     * pupils. the GazeTracker does not take the ownership, the controller
+     * must live as long as the tracker uses it. must not be called while 
+     * the tracker is tracking.
+     * @param controller the controller or NULL for the full quality
+     */
+    void setQualityController(QualityController *controller);
     
     /**
      * this method blocks the callee and searches for a eye region in the camera sight.
      * useful for waiting until the tracking can be started
+     * <br />the ImageSource delivers full frames again afterwards
      */
     void initializeCalibration();
 
+    /**
+     * @return the number of frames the ImageSource dropped since this tracker
+     *  has been created
+     * @see DeliveryPolicy
+     */
+    unsigned long getDroppedFrames() const;
+
+    /**
+     * replaces the tuning values of this tracker. must not be called while
+     * the tracker is tracking.
+     * @param config the new config, e.g. TrackerConfig() to take over the
+     *  values the user has changed in the GazeConfig
+     * @throws GazeException if the config selects cascades which could not
+     *  be loaded, the config is not changed then
+     */
+    void setConfig(const TrackerConfig &config);
+
+    const TrackerConfig& getConfig() const;
+
 private:    
-    
+    friend class PipelineStage;
+    friend class EyeChannel;
+
+    /**
+     * a frame on its way through the pipelined tracking
+     */
+    struct PipelineFrame {
+        /// the eye region of the frame is measured.image, the result is 
+        /// MEASURE_OK until a stage fails
+        FrameResult measured;
+        /// the glints in eye region coordinates, where the starburst starts
+        vector<cv::Point> glints;
+        Point2f glintCenter;
+        /// the glint distance of the FindGlints after this frame
+        double glintDistance;
+        /// true if the eye region has been found again with this frame
+        bool restarted;
+        /// the number of frames the source dropped before this frame
+        unsigned long droppedFrames;
+
+        PipelineFrame() : glintDistance(0), restarted(false), droppedFrames(0) {
+            measured.result = MEASURE_OK;
+        }
+    };
+
     ImageSource& imageSrc;
+    TrackerConfig config;
     FindGlints glintFinder;
     Starburst starburst;
     Calibration c;
     TrackerCallback *tracker_callback;
-    Point2f last_gaze_vectors[GazeConfig::NUM_OF_SMOOTHING_FRAMES];
+    /// the moving average, used if no other filter has been set
+    BoxFilter defaultFilter;
+    GazeFilter *gazeFilter;
+    /// lowers the quality under load (may be NULL)
+    QualityController *qualityController;
+    /// the last measured GazeVector, for the confidence of the next one
+    Point2f lastGazeVector;
+    bool hasGazeVector;
     bool isRunning;
-    unsigned int framenumber;
     FindEyeRegion eyeFinder;
     Rect frameRegion;     
+    /// moves and sizes the frameRegion
+    RegionPredictor regionPredictor;
+    /// the size of the eye region found by the haar classifier
+    Size eyeSize;
+    /// the last glint center found (full frame coordinates), where the lost
+    /// glints are searched first
+    Point2f lastGlintCenter;
+    /// searches the eye region while the tracking goes on
+    EyeRegionWorker eyeWorker;
+    /// the number of frames without glints since the eye region was found
+    int noGlints;
+    /// the number of frames since the eye has been lost (0 while tracking)
+    int lostFrames;
+    /// the number of searches of the eyeWorker which have not found the eye
+    int eyeSearches;
+    /// follows the eye while the glints are hidden
+    EyeTemplateTracker eyeTemplate;
+    /// the number of frames in a row the eye has been followed by the eyeTemplate
+    int templateFrames;
+    FrameInfo frameInfo;
+    unsigned long droppedFrames;
+
+    bool pipelined;
+    /// dropped frames which have not been reported to the callback yet
+    unsigned long pendingDroppedFrames;
+    /// the queues between the stages (only while pipelined tracking)
+    SpscQueue<PipelineFrame> *glintQueue;
+    SpscQueue<PipelineFrame> *pupilQueue;
+
+    bool binocular;
+    bool synchronousEyeSearch;
 
     void getNextFrame(Mat & frame);
+    void updateRegionOfInterest();
+    void cropToFrameRegion(Mat & frame);
+    static Mat cropToRegion(const Mat & frame, const Point & offset, Rect & region);
     bool findEyeRegion(Mat & frame, cv::Point2f& frameCenter, bool calibrationMode = false);
+    bool nextFrameRegion(const Mat & frame, cv::Point2f& glintCenter);
+    Rect lostEyeWindow() const;
+    void searchLostEye(const Mat & frame, bool binocular);
+    EyeSearchState pollLostEye(const Mat & frame, bool binocular, Rect regions[NUM_OF_EYES]);
+    bool followGlints(const Mat & eyeImage, MeasureResult result, cv::Point2f& glintCenter);
+    bool followEyeTemplate(const Mat & eyeImage);
+    void restartEyeRegion(const Rect & region, cv::Point2f& glintCenter);
+    void findEyeRegions(Mat & frame, Rect eyeRegions[NUM_OF_EYES]);
 
-    void smoothSignal(Point2f &measured, Point2f &smoothed, Point2f data[], unsigned int framenumber);
-    MeasureResult measureFrame(Mat &frame, Point2f &gazeVector, Point2f glintCenter);
+    void trackSequential(unsigned int duration);
+    void trackPipelined(unsigned int duration);
+    void glintStage();
+    void pupilStage();
+    void trackBinocular(unsigned int duration);
+    void restartSmoothing();
+    TrackerConfig qualityConfig() const;
+    bool adaptQuality(int64 startTick, FrameResult &frameResult);
+    float gazeConfidence(const Point2f &gazeVector, double glintDistance);
+    bool publishResult(FrameResult &frameResult, double glintDistance);
+    MeasureResult measureFrame(Mat &frame, Point2f glintCenter,
+            FrameResult &frameResult);
+    MeasureResult measurePupil(Mat &frame, vector<cv::Point> &glints, 
+            Point2f glintCenter, FrameResult &frameResult);
 
 
 
 protected:
-    void adjustRect(cv::Point2f& currentCenter, cv::Rect& frameRegion);
 
 
 
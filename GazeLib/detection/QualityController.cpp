@@ -0,0 +1,110 @@
+#include <algorithm>
+
+#include "QualityController.hpp"
+#include "../exception/GazeExceptions.hpp"
+
+using namespace std;
+
+/// how fast the average processing time follows the frames
+static const double AVERAGE_ADAPTION = 0.2;
+/// the number of frames measured after a change before the next change
+static const int SETTLE_FRAMES = 5;
+/// the quality is raised if the frames take less than this part of the target
+static const double HEADROOM = 0.75;
+/// ... for this many frames in a row
+static const int RECOVERY_FRAMES = 30;
+
+/// the pupil search needs at least a few rays and iterations
+static const unsigned int MIN_STARBURST_RAYS = 8;
+static const unsigned int MIN_STARBURST_ITERATIONS = 3;
+static const unsigned int MIN_RANSAC_ITERATIONS = 50;
+
+/**
+ * scales a value of the config, but not below the minimum (unless the value
+ * is smaller already)
+ */
+static unsigned int scale(unsigned int value, int percent, unsigned int minimum) {
+    unsigned int scaled = value * percent / 100;
+    return max(scaled, min(value, minimum));
+}
+
+QualityController::QualityController(double targetFramePeriod, int minPercent) :
+minPercent(minPercent) {
+    if (minPercent < 1 || minPercent > 100)
+        throw WrongArgumentException("The minimum quality must be between 1 and 100 percent");
+
+    setTargetFramePeriod(targetFramePeriod);
+    reset();
+}
+
+void QualityController::setTargetFramePeriod(double targetFramePeriod) {
+    if (targetFramePeriod <= 0)
+        throw WrongArgumentException("The target frame period must be positive");
+
+    targetMicros = targetFramePeriod * 1000;
+}
+
+void QualityController::reset() {
+    setPercent(100);
+}
+
+void QualityController::setPercent(int percent) {
+    this->percent = percent;
+    hasAverage = false;
+    averageMicros = 0;
+    framesSinceChange = 0;
+    relaxedFrames = 0;
+}
+
+bool QualityController::update(double processingMicros) {
+    if (hasAverage)
+        averageMicros += (processingMicros - averageMicros) * AVERAGE_ADAPTION;
+    else
+        averageMicros = processingMicros;
+    hasAverage = true;
+
+    // the average has to follow the last change first
+    if (++framesSinceChange < SETTLE_FRAMES)
+        return false;
+
+    if (averageMicros > targetMicros) {
+        relaxedFrames = 0;
+        if (percent == minPercent)
+            return false;
+
+        // the pupil search takes most of the time and shrinks with the
+        // quality. far too slow frames skip some steps
+        const int step = GazeConfig::QUALITY_STEP_PERCENT;
+        int needed = (int) (percent * targetMicros / averageMicros) / step * step;
+        setPercent(max(min(needed, percent - step), minPercent));
+        return true;
+    }
+
+    if (averageMicros < targetMicros * HEADROOM && percent < 100) {
+        if (++relaxedFrames >= RECOVERY_FRAMES) {
+            setPercent(min(percent + GazeConfig::QUALITY_STEP_PERCENT, 100));
+            return true;
+        }
+    } else {
+        relaxedFrames = 0;
+    }
+
+    return false;
+}
+
+int QualityController::qualityPercent() const {
+    return percent;
+}
+
+TrackerConfig QualityController::apply(const TrackerConfig& config) const {
+    TrackerConfig scaled = config;
+    scaled.starburstRays = scale(config.starburstRays, percent, MIN_STARBURST_RAYS);
+    scaled.starburstIterations = scale(config.starburstIterations, percent,
+            MIN_STARBURST_ITERATIONS);
+    scaled.ransacIterations = scale(config.ransacIterations, percent, MIN_RANSAC_ITERATIONS);
+    return scaled;
+}
+
+double QualityController::averageProcessingMicros() const {
+    return averageMicros;
+}
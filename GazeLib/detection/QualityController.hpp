@@ -0,0 +1,93 @@
+#ifndef QUALITYCONTROLLER_HPP_
+#define QUALITYCONTROLLER_HPP_
+
+#include "../config/GazeConfig.hpp"
+#include "../config/TrackerConfig.hpp"
+
+/**
+ * The QualityController keeps the GazeTracker at a steady frame rate on a
+ * busy machine. it watches the processing time of the frames and lowers the
+ * quality of the pupil search (starburst rays, starburst iterations and
+ * RANSAC iterations) when the frames take longer than the target frame
+ * period. when there is enough headroom again the quality is raised step by
+ * step up to the full quality.
+ * <br />the quality is given in percent of the TrackerConfig, it changes in
+ * steps of GazeConfig::QUALITY_STEP_PERCENT and never falls below the
+ * minimum. after every change some frames are measured before the next
+ * change, so the quality does not oscillate.
+ * <br />the controller is not thread safe, the GazeTracker updates it on the
+ * thread which searches the pupils. clients read the quality of a frame from
+ * FrameResult::qualityPercent.
+ *
+ * usage:
+ * <pre>
+ * QualityController controller(1000. / 30); // 30 frames per second
+ * tracker.setQualityController(&controller);
+ * </pre>
+ * @see GazeTracker::setQualityController()
+ */
+class QualityController {
+private:
+    /// the processing time of a frame must not exceed this
+    double targetMicros;
+    int minPercent;
+    int percent;
+    /// the moving average of the processing time since the last change
+    double averageMicros;
+    bool hasAverage;
+    /// the number of frames since the last change
+    int framesSinceChange;
+    /// the number of frames in a row which left enough headroom
+    int relaxedFrames;
+
+    void setPercent(int percent);
+
+public:
+    /**
+     * @param targetFramePeriod the time (in milliseconds) a frame may take,
+     *  e.g. the frame period of the camera
+     * @param minPercent the lowest quality in percent
+     * @throws WrongArgumentException if the target is not positive or the
+     *  minimum not between 1 and 100
+     */
+    QualityController(double targetFramePeriod,
+            int minPercent = GazeConfig::QUALITY_MIN_PERCENT);
+
+    /**
+     * takes the processing time of the next frame
+     * @param processingMicros the time the tracker has worked on the frame
+     *  in microseconds (without waiting for the camera)
+     * @return true if the quality has changed
+     */
+    bool update(double processingMicros);
+
+    /**
+     * @return the current quality in percent (100 is the full quality)
+     */
+    int qualityPercent() const;
+
+    /**
+     * scales the values of the pupil search with the current quality
+     * @param config the config with the full quality
+     * @return the config with the current quality
+     */
+    TrackerConfig apply(const TrackerConfig& config) const;
+
+    /**
+     * @return the average processing time since the last change in
+     *  microseconds
+     */
+    double averageProcessingMicros() const;
+
+    /**
+     * @param targetFramePeriod the new target frame period in milliseconds
+     */
+    void setTargetFramePeriod(double targetFramePeriod);
+
+    /**
+     * returns to the full quality and forgets the processing times
+     */
+    void reset();
+};
+
+#endif /* QUALITYCONTROLLER_HPP_ */
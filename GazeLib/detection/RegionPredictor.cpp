@@ -0,0 +1,108 @@
+#include <cmath>
+
+#include "RegionPredictor.hpp"
+#include "../config/GazeConfig.hpp"
+
+using namespace std;
+using namespace cv;
+
+/// the variance of the head acceleration (pixels per frame^2)^2
+static const float ACCELERATION_NOISE = 4;
+/// the variance of the measured glint center (pixels^2)
+static const float MEASUREMENT_NOISE = 1;
+/// the variance of the head velocity after the eye has been found
+static const float INITIAL_VELOCITY_VARIANCE = 16;
+/// how fast the average prediction error follows the measurements
+static const float INNOVATION_ADAPTION = 0.2f;
+
+RegionPredictor::RegionPredictor() : filter(4, 2, 0, CV_32F),
+measurement(2, 1, CV_32F), lastSequenceNumber(0) {
+    setIdentity(filter.transitionMatrix);
+    setIdentity(filter.measurementMatrix);
+    setIdentity(filter.measurementNoiseCov, Scalar(MEASUREMENT_NOISE));
+}
+
+void RegionPredictor::reset(const Rect& eyeRegion, unsigned long sequenceNumber) {
+    eyeSize = eyeRegion.size();
+    lastSequenceNumber = sequenceNumber;
+    innovation = Point2f();
+
+    // the glints are somewhere near the center of the eye
+    filter.statePost = Mat::zeros(4, 1, CV_32F);
+    filter.statePost.at<float>(0) = eyeRegion.x + eyeRegion.width / 2.f;
+    filter.statePost.at<float>(1) = eyeRegion.y + eyeRegion.height / 2.f;
+
+    filter.errorCovPost = Mat::zeros(4, 4, CV_32F);
+    filter.errorCovPost.at<float>(0, 0) = eyeRegion.width * eyeRegion.width / 64.f;
+    filter.errorCovPost.at<float>(1, 1) = eyeRegion.height * eyeRegion.height / 64.f;
+    filter.errorCovPost.at<float>(2, 2) = INITIAL_VELOCITY_VARIANCE;
+    filter.errorCovPost.at<float>(3, 3) = INITIAL_VELOCITY_VARIANCE;
+
+    filter.statePre = filter.statePost.clone();
+    filter.errorCovPre = filter.errorCovPost.clone();
+}
+
+Rect RegionPredictor::predict(unsigned long sequenceNumber) {
+    // dropped frames are a longer step in time
+    float dt = 1;
+    if (sequenceNumber > lastSequenceNumber && lastSequenceNumber > 0)
+        dt = sequenceNumber - lastSequenceNumber;
+    lastSequenceNumber = sequenceNumber;
+
+    filter.transitionMatrix.at<float>(0, 2) = dt;
+    filter.transitionMatrix.at<float>(1, 3) = dt;
+
+    // a random acceleration during dt
+    float dt2 = dt * dt;
+    filter.processNoiseCov = Mat::zeros(4, 4, CV_32F);
+    for (int i = 0; i < 2; ++i) {
+        filter.processNoiseCov.at<float>(i, i) = ACCELERATION_NOISE * dt2 * dt2 / 4;
+        filter.processNoiseCov.at<float>(i, i + 2) = ACCELERATION_NOISE * dt2 * dt / 2;
+        filter.processNoiseCov.at<float>(i + 2, i) = ACCELERATION_NOISE * dt2 * dt / 2;
+        filter.processNoiseCov.at<float>(i + 2, i + 2) = ACCELERATION_NOISE * dt2;
+    }
+
+    filter.predict();
+
+    // the region covers the eye and the uncertainty of the prediction
+    Point2f center = predictedCenter();
+    Size2f sigma = uncertainty();
+    const float sigmas = GazeConfig::REGION_PREDICTION_SIGMAS;
+
+    float width = eyeSize.width * GazeConfig::REGION_MIN_SCALE_PERCENT / 100.f
+            + 2 * sigmas * sigma.width;
+    float height = eyeSize.height * GazeConfig::REGION_MIN_SCALE_PERCENT / 100.f
+            + 2 * sigmas * sigma.height;
+
+    width = min(width, eyeSize.width * GazeConfig::REGION_MAX_SCALE_PERCENT / 100.f);
+    height = min(height, eyeSize.height * GazeConfig::REGION_MAX_SCALE_PERCENT / 100.f);
+
+    int x = cvRound(center.x - width / 2);
+    int y = cvRound(center.y - height / 2);
+
+    return Rect(max(x, 0), max(y, 0), cvRound(width), cvRound(height));
+}
+
+void RegionPredictor::correct(const Point2f& glintCenter) {
+    Point2f error = glintCenter - predictedCenter();
+    innovation.x += INNOVATION_ADAPTION * (fabs(error.x) - innovation.x);
+    innovation.y += INNOVATION_ADAPTION * (fabs(error.y) - innovation.y);
+
+    measurement.at<float>(0) = glintCenter.x;
+    measurement.at<float>(1) = glintCenter.y;
+    filter.correct(measurement);
+}
+
+Point2f RegionPredictor::predictedCenter() const {
+    return Point2f(filter.statePre.at<float>(0), filter.statePre.at<float>(1));
+}
+
+Size2f RegionPredictor::uncertainty() const {
+    // the covariance of the filter does not depend on the measurements, the
+    // recent prediction errors show how fast the head actually moves
+    float varianceX = filter.errorCovPre.at<float>(0, 0);
+    float varianceY = filter.errorCovPre.at<float>(1, 1);
+
+    return Size2f(sqrt(varianceX + innovation.x * innovation.x),
+            sqrt(varianceY + innovation.y * innovation.y));
+}
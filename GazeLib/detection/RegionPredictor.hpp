@@ -0,0 +1,77 @@
+#ifndef REGIONPREDICTOR_HPP_
+#define REGIONPREDICTOR_HPP_
+
+#include <opencv2/core/core.hpp>
+#include <opencv2/video/tracking.hpp>
+
+/**
+ * The RegionPredictor moves the eye region with the glints. a constant
+ * velocity kalman filter predicts where the glint center will be in the next
+ * frame, the region is centered at the prediction.
+ * <br />the size of the region follows the uncertainty of the prediction:
+ * while the head is still the region shrinks below the size of the eye
+ * found by the haar classifier, when the head moves fast or the glints are
+ * missed it grows (up to GazeConfig::REGION_MAX_SCALE_PERCENT of the eye).
+ * <br />all positions are in full frame coordinates.
+ *
+ * usage:
+ * <pre>
+ * predictor.reset(eyeRegion, frameInfo.sequenceNumber);
+ * while (...) {
+ *     Rect region = predictor.predict(frameInfo.sequenceNumber);
+ *     if (findGlints(frame(region), glints, glintCenter))
+ *         predictor.correct(glintCenter + region.tl());
+ * }
+ * </pre>
+ */
+class RegionPredictor {
+private:
+    /// state: x, y, vx, vy (pixels and pixels per frame), measurement: x, y
+    cv::KalmanFilter filter;
+    cv::Mat measurement;
+    /// the size of the eye found by the haar classifier
+    cv::Size eyeSize;
+    /// the average distance between the predicted and the measured center
+    cv::Point2f innovation;
+    unsigned long lastSequenceNumber;
+
+public:
+    RegionPredictor();
+
+    /**
+     * restarts the prediction at the eye region found by the haar classifier.
+     * the head is assumed to be still
+     * @param eyeRegion the eye region
+     * @param sequenceNumber the sequence number of the frame the eye has
+     *  been found in
+     */
+    void reset(const cv::Rect& eyeRegion, unsigned long sequenceNumber = 0);
+
+    /**
+     * predicts the eye region of a frame. frames without a call of
+     * correct() increase the uncertainty and therefore the region.
+     * @param sequenceNumber the sequence number of the frame, the time
+     *  since the last frame is taken from the difference (dropped frames)
+     * @return the predicted eye region
+     */
+    cv::Rect predict(unsigned long sequenceNumber = 0);
+
+    /**
+     * corrects the last prediction with the measured glint center
+     * @param glintCenter the glint center in full frame coordinates
+     */
+    void correct(const cv::Point2f& glintCenter);
+
+    /**
+     * @return the predicted glint center
+     */
+    cv::Point2f predictedCenter() const;
+
+    /**
+     * @return the standard deviation of the predicted glint center, including
+     *  the recent prediction errors
+     */
+    cv::Size2f uncertainty() const;
+};
+
+#endif /* REGIONPREDICTOR_HPP_ */
@@ -0,0 +1,99 @@
+#include "CascadeCache.hpp"
+#include "../../config/GazeConfig.hpp"
+#include "../../exception/GazeExceptions.hpp"
+#include "../../utils/log.hpp"
+
+using namespace std;
+using namespace cv;
+
+CascadeCache::CascadeCache() {
+}
+
+CascadeCache::~CascadeCache() {
+    map<string, vector<CascadeClassifier*> >::iterator it;
+    for (it = idle.begin(); it != idle.end(); ++it)
+        for (unsigned int i = 0; i < it->second.size(); ++i)
+            delete it->second[i];
+}
+
+CascadeCache& CascadeCache::instance() {
+    static CascadeCache cache;
+    return cache;
+}
+
+/**
+ * parses the XML of the cascade
+ * @param file the cascade file
+ * @return the new classifier
+ * @throws GazeException if the file could not be loaded
+ */
+CascadeClassifier* CascadeCache::load(const string& file) {
+    CascadeClassifier* classifier = new CascadeClassifier();
+    if (!classifier->load(GazeConfig::inWorkingDir(file))) {
+        delete classifier;
+        throw GazeException("ERROR: Could not load classifier cascade " + file);
+    }
+
+    LOG_D("Cascade loaded: " << file);
+    return classifier;
+}
+
+CascadeClassifier* CascadeCache::acquire(const string& file) {
+    {
+        ScopedLock lock(mutex);
+        vector<CascadeClassifier*>& classifiers = idle[file];
+        if (!classifiers.empty()) {
+            CascadeClassifier* classifier = classifiers.back();
+            classifiers.pop_back();
+            return classifier;
+        }
+    }
+
+    // the cache is not locked while the XML is parsed, other files (and
+    // idle classifiers) are available meanwhile
+    return load(file);
+}
+
+void CascadeCache::release(const string& file, CascadeClassifier* classifier) {
+    if (classifier == NULL)
+        return;
+
+    ScopedLock lock(mutex);
+    idle[file].push_back(classifier);
+}
+
+void CascadeCache::preload(const string& file, unsigned int count) {
+    for (unsigned int idleClassifiers = idleCount(file); idleClassifiers < count;
+            ++idleClassifiers)
+        release(file, load(file));
+}
+
+unsigned int CascadeCache::idleCount(const string& file) {
+    ScopedLock lock(mutex);
+    return idle[file].size();
+}
+
+CascadeLease::CascadeLease() : classifier(NULL) {
+}
+
+CascadeLease::~CascadeLease() {
+    release();
+}
+
+void CascadeLease::acquire(const string& file) {
+    if (isLoaded() && this->file == file)
+        return;
+
+    release();
+    classifier = CascadeCache::instance().acquire(file);
+    this->file = file;
+}
+
+void CascadeLease::release() {
+    CascadeCache::instance().release(file, classifier);
+    classifier = NULL;
+}
+
+bool CascadeLease::isLoaded() const {
+    return classifier != NULL;
+}
@@ -0,0 +1,125 @@
+#ifndef CASCADECACHE_HPP_
+#define CASCADECACHE_HPP_
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include <opencv2/objdetect/objdetect.hpp>
+
+#include "../../utils/threads.hpp"
+
+/**
+ * The CascadeCache keeps the cascade classifiers loaded by the process.
+ * parsing the XML of a cascade takes much longer than a search, so a 
+ * classifier is loaded once and reused by the next FindEyeRegion (e.g. a
+ * restarted GazeTracker).
+ * <br />a CascadeClassifier keeps the state of its last search, it must not
+ * be used by two threads at once. so the cache lends every classifier to a
+ * single CascadeLease, and concurrent users get their own classifiers. the
+ * classifiers given back are kept until the end of the process.
+ * <br />the files are relative to the working directory
+ * (GazeConfig::inWorkingDir()).
+ */
+class CascadeCache {
+private:
+    Mutex mutex;
+    /// the loaded classifiers which are not lent, by their file
+    std::map<std::string, std::vector<cv::CascadeClassifier*> > idle;
+
+    CascadeCache();
+    ~CascadeCache();
+
+    static cv::CascadeClassifier* load(const std::string& file);
+
+    CascadeCache(const CascadeCache&);
+    CascadeCache& operator=(const CascadeCache&);
+
+public:
+    /**
+     * @return the cache of the process
+     */
+    static CascadeCache& instance();
+
+    /**
+     * lends a classifier, it is loaded if no loaded one is idle
+     * @param file the cascade file
+     * @return the classifier, it has to be given back with release()
+     * @throws GazeException if the file could not be loaded
+     */
+    cv::CascadeClassifier* acquire(const std::string& file);
+
+    /**
+     * gives a classifier back
+     * @param file the cascade file the classifier has been acquired with
+     * @param classifier the classifier
+     */
+    void release(const std::string& file, cv::CascadeClassifier* classifier);
+
+    /**
+     * loads classifiers in advance, e.g. while the camera is opened
+     * @param file the cascade file
+     * @param count the number of classifiers which should be idle afterwards
+     * @throws GazeException if the file could not be loaded
+     */
+    void preload(const std::string& file, unsigned int count = 1);
+
+    /**
+     * @param file the cascade file
+     * @return the number of loaded classifiers which are not lent
+     */
+    unsigned int idleCount(const std::string& file);
+};
+
+/**
+ * a classifier lent by the CascadeCache, it is given back at the 
+ * destruction (or when another file is acquired)
+ *
+ * usage:
+ * <pre>
+ * CascadeLease eyeCascade;
+ * eyeCascade.acquire("../__haarcascades/haarcascade_eye.xml");
+ * eyeCascade->detectMultiScale(...);
+ * </pre>
+ */
+class CascadeLease {
+private:
+    std::string file;
+    cv::CascadeClassifier* classifier;
+
+    CascadeLease(const CascadeLease&);
+    CascadeLease& operator=(const CascadeLease&);
+
+public:
+    CascadeLease();
+    ~CascadeLease();
+
+    /**
+     * gives the current classifier back and lends one of the file. nothing
+     * happens if the file is the current one
+     * @param file the cascade file
+     * @throws GazeException if the file could not be loaded, the lease is
+     *  empty afterwards
+     */
+    void acquire(const std::string& file);
+
+    /**
+     * gives the classifier back
+     */
+    void release();
+
+    /**
+     * @return true if a classifier is lent
+     */
+    bool isLoaded() const;
+
+    cv::CascadeClassifier* operator->() const {
+        return classifier;
+    }
+
+    cv::CascadeClassifier& operator*() const {
+        return *classifier;
+    }
+};
+
+#endif /* CASCADECACHE_HPP_ */
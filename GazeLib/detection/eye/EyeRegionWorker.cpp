@@ -0,0 +1,169 @@
+#include "EyeRegionWorker.hpp"
+#include "../../utils/log.hpp"
+#include "../../exception/GazeExceptions.hpp"
+
+EyeRegionWorker::EyeRegionWorker(const TrackerConfig& config) :
+glintFinder(config), eyeFinder(glintFinder, config), binocular(false),
+busy(false), state(EYE_SEARCH_IDLE), generation(0), config(config),
+configChanged(false), stopped(false), synchronous(false) {
+}
+
+EyeRegionWorker::~EyeRegionWorker() {
+    {
+        ScopedLock lock(mutex);
+        stopped = true;
+        requested.signal();
+    }
+    join();
+}
+
+void EyeRegionWorker::setConfig(const TrackerConfig& config) {
+    ScopedLock lock(mutex);
+    this->config = config;
+    configChanged = true;
+}
+
+void EyeRegionWorker::setSynchronous(bool synchronous) {
+    ScopedLock lock(mutex);
+    this->synchronous = synchronous;
+}
+
+bool EyeRegionWorker::search(const Mat& frame, const FrameInfo& frameInfo,
+        bool binocular, const Rect& searchHint) {
+    ScopedLock lock(mutex);
+    if (busy || stopped)
+        return false;
+
+    ++generation;
+    if (synchronous) {
+        // the tracker waits for the result, the frame is not copied
+        applyConfig();
+        if (searchHint.area() > 0)
+            eyeFinder.setSearchHint(searchHint - frameInfo.region.tl());
+
+        Rect found[NUM_OF_EYES];
+        setResult(find(frame, binocular, found), found, frameInfo.region.tl());
+        return true;
+    }
+
+    if (!isStarted())
+        start();
+
+    // the frame only lives until the tracker grabs the next one (the source
+    // reuses its buffer), the search outlasts it
+    this->frame = frame.clone();
+    offset = frameInfo.region.tl();
+    this->binocular = binocular;
+    this->searchHint = searchHint - offset;
+    busy = true;
+    state = EYE_SEARCH_RUNNING;
+    requested.signal();
+    return true;
+}
+
+EyeSearchState EyeRegionWorker::poll(Rect regions[NUM_OF_EYES]) {
+    ScopedLock lock(mutex);
+    EyeSearchState result = state;
+
+    if (state == EYE_SEARCH_FOUND || state == EYE_SEARCH_NOT_FOUND) {
+        for (int eye = 0; eye < NUM_OF_EYES; ++eye)
+            regions[eye] = this->regions[eye];
+        state = EYE_SEARCH_IDLE;
+    }
+
+    return result;
+}
+
+void EyeRegionWorker::cancel() {
+    ScopedLock lock(mutex);
+    ++generation;
+    state = EYE_SEARCH_IDLE;
+}
+
+bool EyeRegionWorker::isBusy() {
+    ScopedLock lock(mutex);
+    return busy;
+}
+
+void EyeRegionWorker::run() {
+    while (true) {
+        Mat searched;
+        Point searchedOffset;
+        bool searchBoth;
+        unsigned long searchedGeneration;
+
+        mutex.lock();
+        while (!stopped && !busy)
+            requested.wait(mutex);
+        if (stopped) {
+            mutex.unlock();
+            break;
+        }
+
+        applyConfig();
+        searched = frame;
+        frame = Mat();
+        searchedOffset = offset;
+        searchBoth = binocular;
+        if (searchHint.area() > 0)
+            eyeFinder.setSearchHint(searchHint);
+        searchedGeneration = generation;
+        mutex.unlock();
+
+        Rect found[NUM_OF_EYES];
+        bool foundEye = find(searched, searchBoth, found);
+
+        ScopedLock lock(mutex);
+        busy = false;
+        if (searchedGeneration != generation)
+            continue; // cancelled
+
+        setResult(foundEye, found, searchedOffset);
+    }
+}
+
+/**
+ * takes over a changed config, the mutex must be locked
+ */
+void EyeRegionWorker::applyConfig() {
+    if (!configChanged)
+        return;
+
+    glintFinder.setConfig(config);
+    try {
+        eyeFinder.setConfig(config);
+    } catch (GazeException &e) {
+        LOG_W("The worker keeps its cascades: " << e.what());
+    }
+    configChanged = false;
+}
+
+/**
+ * runs the classifiers
+ * @param frame the frame to search
+ * @param binocular true to search both eyes
+ * @param found the found region(s) in frame coordinates
+ * @return true if the eye region has been found
+ */
+bool EyeRegionWorker::find(const Mat& frame, bool binocular, Rect found[NUM_OF_EYES]) {
+    // the eyeFinder does not write into the frame
+    Mat image = frame;
+    try {
+        if (binocular)
+            return eyeFinder.findEyes(image, found[LEFT_EYE], found[RIGHT_EYE]);
+        return eyeFinder.findEye(image, found[LEFT_EYE]);
+    } catch (std::exception &e) {
+        LOG_W("The eye region search failed: " << e.what());
+    }
+    return false;
+}
+
+/**
+ * publishes the result of a search, the mutex must be locked
+ */
+void EyeRegionWorker::setResult(bool foundEye, const Rect found[NUM_OF_EYES],
+        const Point& offset) {
+    state = foundEye ? EYE_SEARCH_FOUND : EYE_SEARCH_NOT_FOUND;
+    for (int eye = 0; eye < NUM_OF_EYES; ++eye)
+        regions[eye] = found[eye] + offset;
+}
@@ -0,0 +1,147 @@
+#ifndef EYEREGIONWORKER_HPP_
+#define EYEREGIONWORKER_HPP_
+
+#include <opencv2/core/core.hpp>
+
+#include "FindEyeRegion.hpp"
+#include "../glint/FindGlints.hpp"
+#include "../FrameResult.hpp"
+#include "../../video/FrameInfo.hpp"
+#include "../../utils/threads.hpp"
+
+/**
+ * the state of the search of an EyeRegionWorker
+ */
+enum EyeSearchState {
+    /// no search has been started (or its result has been taken)
+    EYE_SEARCH_IDLE,
+    /// the haar classifiers are running
+    EYE_SEARCH_RUNNING,
+    /// the search is done, the eye region has been found
+    EYE_SEARCH_FOUND,
+    /// the search is done, there was no eye region in the frame
+    EYE_SEARCH_NOT_FOUND,
+};
+
+/**
+ * The EyeRegionWorker runs the haar classifiers of a FindEyeRegion on its
+ * own thread. when a GazeTracker has lost the eye it hands a full frame to
+ * the worker and goes on tracking the following frames, so the callback
+ * still gets every frame while the classifiers run. the tracker adopts the
+ * eye region as soon as the worker has found it.
+ * <br />the worker has its own FindGlints and FindEyeRegion and a copy of
+ * the frame, nothing is shared with the thread of the tracker. a search can
+ * not be interrupted, cancel() only drops its result.
+ * <br />a synchronous worker searches the frame in search() itself, on the
+ * thread of the tracker. its result does not depend on the timing of the
+ * threads (e.g. for the BatchTracker). the thread is only started for the
+ * first asynchronous search.
+ *
+ * usage:
+ * <pre>
+ * worker.search(frame, frameInfo);
+ * while (...) {
+ *     // track the next frames
+ *     if (worker.poll(regions) == EYE_SEARCH_FOUND)
+ *         frameRegion = regions[LEFT_EYE];
+ * }
+ * </pre>
+ */
+class EyeRegionWorker : private Thread {
+private:
+    FindGlints glintFinder;
+    FindEyeRegion eyeFinder;
+
+    Mutex mutex;
+    Condition requested;
+
+    /// the frame to search and where it lies in the full frame
+    Mat frame;
+    Point offset;
+    bool binocular;
+    /// where the eyes have been seen last (in frame coordinates)
+    Rect searchHint;
+    /// true from search() until the worker is done with the frame
+    bool busy;
+    EyeSearchState state;
+    /// the found regions in full frame coordinates
+    Rect regions[NUM_OF_EYES];
+    /// counts the searches, the result of a cancelled search is dropped
+    unsigned long generation;
+    /// a config which is taken over before the next search
+    TrackerConfig config;
+    bool configChanged;
+    bool stopped;
+    bool synchronous;
+
+    void applyConfig();
+    bool find(const Mat& frame, bool binocular, Rect found[NUM_OF_EYES]);
+    void setResult(bool foundEye, const Rect found[NUM_OF_EYES], const Point& offset);
+
+protected:
+    void run();
+
+public:
+    /**
+     * loads the haar classifiers. the worker thread is started with the
+     * first asynchronous search
+     * @param config the config of the GazeTracker
+     * @throws GazeException if the classifiers could not be loaded
+     */
+    EyeRegionWorker(const TrackerConfig& config = TrackerConfig());
+
+    /**
+     * waits for a running search and stops the worker thread
+     */
+    ~EyeRegionWorker();
+
+    /**
+     * the config is taken over before the next search
+     * @param config the config of the GazeTracker
+     */
+    void setConfig(const TrackerConfig& config);
+
+    /**
+     * switches the synchronous search on or off (default: off)
+     * @param synchronous true to search in search() on the calling thread
+     */
+    void setSynchronous(bool synchronous);
+
+    /**
+     * starts searching the eye region in a copy of the frame. the result of
+     * the last search is dropped if it has not been taken with poll().
+     * a synchronous worker returns when the search is done, poll() has the
+     * result then
+     * @param frame the frame, should be the full frame
+     * @param frameInfo the FrameInfo of the frame
+     * @param binocular true to search both eyes (FindEyeRegion::findEyes())
+     * @param searchHint where the eye(s) have been seen last in full frame
+     *  coordinates, the search starts around it (FindEyeRegion::setSearchHint()).
+     *  an empty Rect keeps the eyes of the last search of the worker
+     * @return false if the worker is still busy with another frame
+     */
+    bool search(const Mat& frame, const FrameInfo& frameInfo, bool binocular = false,
+            const Rect& searchHint = Rect());
+
+    /**
+     * takes the result of the search. the state is EYE_SEARCH_IDLE afterwards
+     * unless the search is still running
+     * @param regions the found region(s) in full frame coordinates if
+     *  EYE_SEARCH_FOUND. a single eye is regions[LEFT_EYE]
+     * @return the state of the search
+     */
+    EyeSearchState poll(Rect regions[NUM_OF_EYES]);
+
+    /**
+     * drops the result of the running search, e.g. because the tracker
+     * has found the eye itself
+     */
+    void cancel();
+
+    /**
+     * @return true if the worker is busy and does not take a new frame
+     */
+    bool isBusy();
+};
+
+#endif /* EYEREGIONWORKER_HPP_ */
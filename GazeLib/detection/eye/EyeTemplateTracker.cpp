@@ -0,0 +1,78 @@
+#include <opencv2/imgproc/imgproc.hpp>
+
+#include "EyeTemplateTracker.hpp"
+#include "../../config/GazeConfig.hpp"
+#include "../../utils/log.hpp"
+
+using namespace cv;
+
+/// a match with a lower correlation is not the eye
+static const double MIN_CORRELATION = 0.7;
+/// smaller templates match anything
+static const int MIN_TEMPLATE_SIZE = 8;
+
+static const double SCALE = GazeConfig::EYE_TEMPLATE_SCALE_PERCENT / 100.;
+
+/**
+ * @return the image scaled to the size of the template
+ */
+static Mat scaled(const Mat& image) {
+    Mat small;
+    resize(image, small, Size(), SCALE, SCALE, INTER_AREA);
+    return small;
+}
+
+EyeTemplateTracker::EyeTemplateTracker() : correlation(-1) {
+}
+
+void EyeTemplateTracker::update(const Mat& eyeImage, const Point2f& glintCenter,
+        const Size& size) {
+    Rect patch = Rect(cvRound(glintCenter.x - size.width / 2.f),
+            cvRound(glintCenter.y - size.height / 2.f), size.width, size.height)
+            & Rect(Point(), eyeImage.size());
+
+    if (patch.width * SCALE < MIN_TEMPLATE_SIZE || patch.height * SCALE < MIN_TEMPLATE_SIZE) {
+        reset();
+        return;
+    }
+
+    eyeTemplate = scaled(eyeImage(patch));
+    templateGlintCenter = Point2f((glintCenter.x - patch.x) * SCALE,
+            (glintCenter.y - patch.y) * SCALE);
+}
+
+bool EyeTemplateTracker::relocate(const Mat& eyeImage, Point2f& glintCenter) {
+    correlation = -1;
+    if (!hasTemplate())
+        return false;
+
+    Mat small = scaled(eyeImage);
+    if (small.cols < eyeTemplate.cols || small.rows < eyeTemplate.rows)
+        return false;
+
+    Mat correlations;
+    matchTemplate(small, eyeTemplate, correlations, TM_CCOEFF_NORMED);
+    Point best;
+    minMaxLoc(correlations, NULL, &correlation, NULL, &best);
+
+    LOG_D("Eye template correlation: " << correlation);
+    if (correlation < MIN_CORRELATION)
+        return false;
+
+    glintCenter = Point2f((best.x + templateGlintCenter.x) / SCALE,
+            (best.y + templateGlintCenter.y) / SCALE);
+    return true;
+}
+
+bool EyeTemplateTracker::hasTemplate() const {
+    return !eyeTemplate.empty();
+}
+
+double EyeTemplateTracker::lastCorrelation() const {
+    return correlation;
+}
+
+void EyeTemplateTracker::reset() {
+    eyeTemplate.release();
+    correlation = -1;
+}
@@ -0,0 +1,70 @@
+#ifndef EYETEMPLATETRACKER_HPP_
+#define EYETEMPLATETRACKER_HPP_
+
+#include <opencv2/core/core.hpp>
+
+/**
+ * The EyeTemplateTracker follows the eye while its glints are hidden, e.g.
+ * by a partial blink or a reflection. it keeps a patch of the eye around
+ * the glints of the last frame with glints and searches it with the
+ * normalized cross correlation in the eye region of the next frames.
+ * <br />the patch and the eye region are scaled to 
+ * GazeConfig::EYE_TEMPLATE_SCALE_PERCENT, so the search costs much less
+ * than the glint search. a match is only accepted above a minimum
+ * correlation, a closed eye is not found.
+ *
+ * usage:
+ * <pre>
+ * if (glintsFound)
+ *     eyeTemplate.update(eyeImage, glintCenter, templateSize);
+ * else if (eyeTemplate.relocate(eyeImage, glintCenter))
+ *     // the eye is still there, glintCenter is estimated
+ * </pre>
+ */
+class EyeTemplateTracker {
+private:
+    /// the scaled patch of the eye
+    cv::Mat eyeTemplate;
+    /// the position of the glint center in the scaled patch
+    cv::Point2f templateGlintCenter;
+    /// the correlation of the last relocate()
+    double correlation;
+
+public:
+    EyeTemplateTracker();
+
+    /**
+     * takes a new template around the glint center
+     * @param eyeImage the eye region of the frame
+     * @param glintCenter the glint center in the eye region
+     * @param size the size of the patch (at the full resolution), it is
+     *  clipped to the eye region
+     */
+    void update(const cv::Mat& eyeImage, const cv::Point2f& glintCenter, const cv::Size& size);
+
+    /**
+     * searches the template in the eye region
+     * @param eyeImage the eye region of the frame
+     * @param glintCenter the estimated glint center in the eye region
+     * @return false if there is no template or the eye has not been found
+     */
+    bool relocate(const cv::Mat& eyeImage, cv::Point2f& glintCenter);
+
+    /**
+     * @return true if update() has been called since the last reset()
+     */
+    bool hasTemplate() const;
+
+    /**
+     * @return the normalized cross correlation of the best match of the
+     *  last relocate() (-1 to 1)
+     */
+    double lastCorrelation() const;
+
+    /**
+     * drops the template, e.g. because the eye region has been found again
+     */
+    void reset();
+};
+
+#endif /* EYETEMPLATETRACKER_HPP_ */
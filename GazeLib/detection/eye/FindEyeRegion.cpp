@@ -7,6 +7,7 @@
 
 #include "FindEyeRegion.hpp"
 #include "../../utils/log.hpp"
+#include "../../utils/latency.hpp"
 #include "../../config/GazeConfig.hpp"
 
 #include "../../exception/GazeExceptions.hpp"
@@ -14,6 +15,100 @@
 using namespace std;
 using namespace cv;
 
+/// the cascades of the eye search (relative to the working directory)
+static const char* EYE_PAIR_CASCADE = "../__haarcascades/haarcascade_mcs_eyepair_big.xml";
+static const char* EYE_CASCADE = "../__haarcascades/haarcascade_eye.xml";
+
+/// a candidate with the glints this close to its center (relative to its
+/// width) is the eye, the candidates after it are not validated anymore
+static const float CLEARLY_VALID_OFFSET = 0.15f;
+
+/**
+ * searches the glints in the eye candidates of the eye cascade, one
+ * candidate per parallel_for_ iteration. every candidate gets its own copy
+ * of the FindGlints, so the glint distance of the tracker is only adapted
+ * to the candidate which is taken.
+ * <br />the glints of an eye lie on the cornea, so the candidate with the
+ * glints closest to its center wins. a tie goes to the candidate the
+ * cascade has found first.
+ * <br />the first clearly valid candidate ends the search, but only for the
+ * candidates after it: the candidates before it are always validated and
+ * the ones after it never take part in the ranking. so the result does not
+ * depend on the order in which the threads validate the candidates.
+ */
+class EyeCandidateValidation : public ParallelLoopBody {
+private:
+    Mat& image;
+    const vector<Rect>& candidates;
+    const FindGlints& findGlints;
+
+    /// the relative glint offset of each candidate, -1 without glints.
+    /// every candidate is written by one iteration only
+    mutable vector<float> offsets;
+    mutable vector<FindGlints> candidateFindGlints;
+
+    mutable Mutex mutex;
+    /// the index of the first clearly valid candidate (candidates.size()
+    /// while there is none). it only decreases
+    mutable volatile int firstClearlyValid;
+
+    EyeCandidateValidation(const EyeCandidateValidation&);
+    EyeCandidateValidation& operator=(const EyeCandidateValidation&);
+
+public:
+
+    EyeCandidateValidation(Mat& image, const vector<Rect>& candidates,
+            const FindGlints& findGlints) : image(image), candidates(candidates),
+    findGlints(findGlints), offsets(candidates.size(), -1.f),
+    candidateFindGlints(candidates.size(), findGlints),
+    firstClearlyValid(candidates.size()) {
+    }
+
+    virtual void operator()(const Range& range) const {
+        for (int i = range.start; i < range.end; ++i) {
+            // an outdated index only validates a candidate too many
+            if (i > firstClearlyValid)
+                break;
+
+            const Rect& candidate = candidates.at(i);
+            vector<Point> glints;
+            Point2f glintCenter;
+            Mat img = image(candidate);
+            if (!candidateFindGlints[i].findGlints(img, glints, glintCenter))
+                continue;
+
+            Point2f center(candidate.width / 2.f, candidate.height / 2.f);
+            Point2f offset = glintCenter - center;
+            offsets[i] = sqrt(offset.dot(offset)) / candidate.width;
+
+            if (offsets[i] < CLEARLY_VALID_OFFSET) {
+                ScopedLock lock(mutex);
+                if (i < firstClearlyValid)
+                    firstClearlyValid = i;
+            }
+        }
+    }
+
+    /**
+     * @param findGlints takes over the glint distance adapted to the best
+     *  candidate
+     * @return the index of the best candidate, -1 if no candidate has glints
+     */
+    int takeBest(FindGlints& findGlints) const {
+        int last = firstClearlyValid;
+        last = min(last, (int) candidates.size() - 1);
+        int best = -1;
+        for (int i = 0; i <= last; ++i) {
+            if (offsets[i] >= 0 && (best < 0 || offsets[i] < offsets[best]))
+                best = i;
+        }
+
+        if (best >= 0)
+            findGlints = candidateFindGlints[best];
+        return best;
+    }
+};
+
 void takeLeftEye(Rect* r2) {
     r2->width = (r2->width / 2);
 }
@@ -24,65 +119,140 @@ void takeRightEye(Rect* r2) {
     //  return (r1->x > r2->x) ? r1 : r2;
 }
 
-FindEyeRegion::FindEyeRegion(FindGlints& findGlints) : findGlints(findGlints) {
-    if (!eye_region_classifier.load(
-            GazeConfig::inWorkingDir(
-            "../__haarcascades/haarcascade_mcs_eyepair_big.xml"))) {
-        throw GazeException("ERROR: Could not load eyepair classifier cascade");
-    }
-
-    if (!eye_classifier.load(
-            GazeConfig::inWorkingDir(
-            "../__haarcascades/haarcascade_eye.xml"))) {
-        throw GazeException("ERROR: Could not load eye classifier cascade");
-    }
+FindEyeRegion::FindEyeRegion(FindGlints& findGlints, const TrackerConfig& config) :
+findGlints(findGlints), config(config), glintLocator(config) {
+    // the glint pattern needs no classifiers
+    if (!config.locateEyesByGlints)
+        loadCascades();
 
     // Init adjust functions
     rightEyeRegionClipper = &takeRightEye;
     leftEyeRegionClipper = &takeLeftEye;
 }
 
-bool FindEyeRegion::findEye(Mat &image, Rect& eyeRect,
-        eyeRegionAdjustFunction& compareFunc) {
-    vector<Rect> faces;
-    eye_region_classifier.detectMultiScale(image, faces, 1.1, 1,
-            0 | CV_HAAR_SCALE_IMAGE,
-            Size(GazeConfig::HAAR_EYEREGION_MIN_WIDTH,
-            GazeConfig::HAAR_EYEREGION_MIN_HEIGHT));
+void FindEyeRegion::setConfig(const TrackerConfig& config) {
+    if (config.locateEyesByGlints) {
+        eye_region_classifier.release();
+        eye_classifier.release();
+    } else if (!eye_region_classifier.isLoaded() || !eye_classifier.isLoaded()) {
+        try {
+            loadCascades();
+        } catch (GazeException&) {
+            eye_region_classifier.release();
+            eye_classifier.release();
+            throw;
+        }
+    }
 
-    LOG_D("Faces detected: " << faces.size());
-    if (faces.size() < 1) {
+    this->config = config;
+    glintLocator.setConfig(config);
+}
+
+/**
+ * lends the classifiers from the CascadeCache, they are only loaded if no
+ * other FindEyeRegion has given them back
+ */
+void FindEyeRegion::loadCascades() {
+    eye_region_classifier.acquire(EYE_PAIR_CASCADE);
+    eye_classifier.acquire(EYE_CASCADE);
+}
+
+void FindEyeRegion::preloadCascades(unsigned int count) {
+    CascadeCache& cache = CascadeCache::instance();
+    cache.preload(EYE_PAIR_CASCADE, count);
+    cache.preload(EYE_CASCADE, count);
+}
+
+void FindEyeRegion::setSearchHint(const Rect& region) {
+    searchHint = region;
+}
+
+Rect FindEyeRegion::getSearchHint() const {
+    return searchHint;
+}
+
+bool FindEyeRegion::findEyePair(Mat &image, Rect& eyeRegion) {
+    Rect fullFrame(Point(), image.size());
+
+    // the eyes rarely move far, the window around the hint is much smaller
+    // than the frame. it covers an eye pair if the hint is a single eye
+    Rect window = Rect(searchHint.x - searchHint.width, searchHint.y - searchHint.height,
+            3 * searchHint.width, 3 * searchHint.height) & fullFrame;
+
+    bool found = false;
+    if (window.area() > 0 && window != fullFrame)
+        found = detectEyePair(image, window, eyeRegion);
+    if (!found)
+        found = detectEyePair(image, fullFrame, eyeRegion);
+
+    if (!found) {
         LOG_W("No face detected!");
         return false;
     }
 
-    Rect eyeRegion = faces.at(0);
-    rectangle(image, faces.at(0), Scalar(255, 255, 255), 3);
+    searchHint = eyeRegion;
+#if __DEBUG_HAAR == 1
+    Mat debug = image.clone();
+    rectangle(debug, eyeRegion, Scalar(255, 255, 255), 3);
+    imshow("Eye pair", debug);
+#endif
 
+    return true;
+}
+
+/**
+ * runs the eye pair cascade on a downscaled copy of a window of the image
+ * @param image the full frame
+ * @param window the part of the image to search
+ * @param eyeRegion the found eye pair in image coordinates
+ * @return true if an eye pair has been found
+ */
+bool FindEyeRegion::detectEyePair(Mat &image, const Rect& window, Rect& eyeRegion) {
+    double scale = min(max(config.haarScalePercent, 1), 100) / 100.;
+    Size minSize(cvRound(config.haarEyeRegionMinWidth * scale),
+            cvRound(config.haarEyeRegionMinHeight * scale));
+
+    Mat searched = image(window);
+    if (scale < 1)
+        resize(searched, searched, Size(), scale, scale, INTER_AREA);
+    if (searched.cols < minSize.width || searched.rows < minSize.height)
+        return false;
+
+    vector<Rect> faces;
+    eye_region_classifier->detectMultiScale(searched, faces, 1.1, 1,
+            0 | CV_HAAR_SCALE_IMAGE, minSize);
+
+    LOG_D("Faces detected: " << faces.size());
+    if (faces.empty())
+        return false;
+
+    // back to the full resolution, the eye cascade needs all details
+    const Rect& face = faces.at(0);
+    eyeRegion = Rect(cvRound(face.x / scale), cvRound(face.y / scale),
+            cvRound(face.width / scale), cvRound(face.height / scale));
+    eyeRegion = (eyeRegion + window.tl()) & Rect(Point(), image.size());
+
+    return true;
+}
+
+bool FindEyeRegion::findEyeIn(Mat &image, Rect eyeRegion, Rect& eyeRect,
+        eyeRegionAdjustFunction& compareFunc) {
     // Extract right or left part of eye region
     (*compareFunc)( &eyeRegion);
 
     vector<Rect> eyes;
     Mat region = image(eyeRegion);
-    eye_classifier.detectMultiScale(region, eyes, 1.2, 1,
+    eye_classifier->detectMultiScale(region, eyes, 1.2, 1,
             0 | CV_HAAR_SCALE_IMAGE,
             Size(region.rows / 2,
             region.rows / 2) ,
             Size(region.rows ,
             region.rows ));
 
-    LOG_D("Eyes detected before filter: " << eyes.size());
-    // removes all rects with no glints in it
-    removeInvalidRects(region, eyes);
-    LOG_D("Eyes detected after filter: " << eyes.size());
-
-    // No eye detected
-    if (eyes.empty()) {
+    LOG_D("Eyes detected: " << eyes.size());
+    // the rects without glints are no eyes
+    if (!findBestEye(region, eyes, eyeRect))
         return false;
-    }// One or multiple eye detected
-    else if (eyes.size() > 0) {
-        eyeRect = eyes.at(0);
-    }
 
     // Add offset
     eyeRect.x += eyeRegion.x;
@@ -91,38 +261,97 @@ bool FindEyeRegion::findEye(Mat &image, Rect& eyeRect,
     return true;
 }
 
-bool FindEyeRegion::hasGlintsInRect(Mat &image, Rect& eyeRect) {
-    vector<cv::Point> glints;
-    Point2f glintCenter;
-    Mat img = image(eyeRect);
+bool FindEyeRegion::findEye(Mat &image, Rect& eyeRect,
+        eyeRegionAdjustFunction& compareFunc) {
+    ScopedTimer timer(STAGE_FIND_EYE_REGION);
+
+    Rect eyeRegion;
+    if (!findEyePair(image, eyeRegion))
+        return false;
+
+    return findEyeIn(image, eyeRegion, eyeRect, compareFunc);
+}
+
+/**
+ * validates the eye candidates in parallel (EyeCandidateValidation)
+ * @param image the image the candidates have been found in
+ * @param eyes the candidates
+ * @param eyeRect the candidate with the glints closest to its center
+ * @return false if there are no glints in any candidate
+ */
+bool FindEyeRegion::findBestEye(Mat& image, const vector<Rect>& eyes, Rect& eyeRect) {
+    if (eyes.empty())
+        return false;
+
+    EyeCandidateValidation validation(image, eyes, findGlints);
+    parallel_for_(Range(0, eyes.size()), validation);
 
-    return findGlints.findGlints(img, glints, glintCenter);
+    int best = validation.takeBest(findGlints);
+    LOG_D("Best eye candidate: " << best);
+    if (best < 0)
+        return false;
+
+    eyeRect = eyes.at(best);
+    return true;
 }
 
-void FindEyeRegion::removeInvalidRects(Mat& image, vector<Rect>& regions) {
-    std::vector<Rect>::iterator iter;
+/**
+ * locates the eye with the GlintPatternLocator
+ * @param image the frame
+ * @param eyeRect the found eye
+ * @param leftEye true for the left eye. if only one eye has glints it is
+ *  taken for either eye
+ * @return true if there are glints in the frame
+ */
+bool FindEyeRegion::locateEyeByGlints(Mat &image, Rect& eyeRect, bool leftEye) {
+    ScopedTimer timer(STAGE_FIND_EYE_REGION);
 
-    for (iter = regions.begin(); iter != regions.end();) {
-        if (!hasGlintsInRect(image, *iter))
-            iter = regions.erase(iter);
+    vector<Rect> eyes;
+    if (glintLocator.locate(image, eyes, 2) == 0)
+        return false;
 
-        else
-            ++iter;
-    }
+    eyeRect = (leftEye || eyes.size() == 1) ? eyes.front() : eyes.back();
+    return true;
 }
 
 bool FindEyeRegion::findRightEye(Mat &image, Rect& eyeRect) {
+    if (config.locateEyesByGlints)
+        return locateEyeByGlints(image, eyeRect, false);
 
     return findEye(image, eyeRect, rightEyeRegionClipper);
 }
 
 bool FindEyeRegion::findLeftEye(Mat &image, Rect& eyeRect) {
+    if (config.locateEyesByGlints)
+        return locateEyeByGlints(image, eyeRect, true);
 
     return findEye(image, eyeRect, leftEyeRegionClipper);
 }
 
+bool FindEyeRegion::findEyes(Mat &image, Rect& leftEyeRect, Rect& rightEyeRect) {
+    ScopedTimer timer(STAGE_FIND_EYE_REGION);
+
+    if (config.locateEyesByGlints) {
+        vector<Rect> eyes;
+        if (glintLocator.locate(image, eyes, 2) < 2)
+            return false;
+
+        leftEyeRect = eyes[0];
+        rightEyeRect = eyes[1];
+        return true;
+    }
+
+    // both eyes are searched in the same eye pair
+    Rect eyeRegion;
+    if (!findEyePair(image, eyeRegion))
+        return false;
+
+    return findEyeIn(image, eyeRegion, leftEyeRect, leftEyeRegionClipper)
+            && findEyeIn(image, eyeRegion, rightEyeRect, rightEyeRegionClipper);
+}
+
 bool FindEyeRegion::findEye(Mat &image, Rect& eyeRect) {
-    if (GazeConfig::DETECT_LEFT_EYE)
+    if (config.detectLeftEye)
         return findLeftEye(image, eyeRect);
     else
         return findRightEye(image, eyeRect);
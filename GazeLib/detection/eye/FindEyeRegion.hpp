@@ -1,9 +1,15 @@
+#ifndef FINDEYEREGION_HPP_
+#define FINDEYEREGION_HPP_
+
 #include <string>
 
 #include <opencv2/core/core.hpp>
 #include <opencv2/objdetect/objdetect.hpp>
 
+#include "CascadeCache.hpp"
+#include "GlintPatternLocator.hpp"
 #include "../glint/FindGlints.hpp"
+#include "../../utils/threads.hpp"
 
 using namespace std;
 using namespace cv;
@@ -18,25 +24,79 @@ typedef void (*eyeRegionAdjustFunction)(Rect*);
  * left/right eye. 
  * 
  * This class uses two haar cascades to identify these regions.
- * 
+ * the classifiers are lent by the CascadeCache, so a new FindEyeRegion usually does not parse
+ * the cascades again.
+ * <br />the eye pair cascade searches a downscaled copy of the frame
+ * (TrackerConfig::haarScalePercent), first in a window around the eyes
+ * found last (or the search hint), then in the whole frame. the eye
+ * cascade searches the eye pair at the full resolution.
+ * <br />the eye candidates of the eye cascade are validated in parallel, 
+ * the candidate with the glints closest to its center is the eye.
+ * <br />with TrackerConfig::locateEyesByGlints the cascades are not used,
+ * the GlintPatternLocator finds the eyes by their glints.
  */
 class FindEyeRegion {
 private:
     FindGlints& findGlints;
+    TrackerConfig config;
 
     eyeRegionAdjustFunction leftEyeRegionClipper;
     eyeRegionAdjustFunction rightEyeRegionClipper;
-    cv::CascadeClassifier eye_region_classifier;
-    cv::CascadeClassifier eye_classifier;
+    CascadeLease eye_region_classifier;
+    CascadeLease eye_classifier;
+    GlintPatternLocator glintLocator;
+    /// where the eyes have been found last (full frame coordinates)
+    Rect searchHint;
+    bool findEyePair(Mat &image, Rect& eyeRegion);
+    bool detectEyePair(Mat &image, const Rect& window, Rect& eyeRegion);
+    bool findEyeIn(Mat &image, Rect eyeRegion, Rect& eyeRect,
+            eyeRegionAdjustFunction& compareFunc);
     bool findEye(Mat &image, Rect& eyeRect, eyeRegionAdjustFunction& compareFunc);
-    bool hasGlintsInRect(Mat &image, Rect& eyeRect);
-    void removeInvalidRects(Mat& image, vector<Rect>& regions);
+    bool findBestEye(Mat& image, const vector<Rect>& eyes, Rect& eyeRect);
+    bool locateEyeByGlints(Mat &image, Rect& eyeRect, bool leftEye);
+    void loadCascades();
 public:
     /**
      * 
      * @param findGlints 
+     * @param config the minimum eye region size and the eye to detect
+     * @throws GazeException if the config selects the cascades and they
+     *  could not be loaded
+     */
+    FindEyeRegion(FindGlints& findGlints, const TrackerConfig& config = TrackerConfig());
+
+    /**
+     * loads the cascades when the config switches back from the glint
+     * pattern to them, gives them back to the CascadeCache otherwise
+     * @param config the config of the GazeTracker
+     * @throws GazeException if the cascades could not be loaded, the config
+     *  is not changed then
      */
-    FindEyeRegion(FindGlints& findGlints);
+    void setConfig(const TrackerConfig& config);
+
+    /**
+     * loads the cascades into the CascadeCache in advance, so the next
+     * FindEyeRegions start without parsing them
+     * @param count the number of FindEyeRegions which will search at the 
+     *  same time (a GazeTracker has two)
+     * @throws GazeException if the cascades could not be loaded
+     */
+    static void preloadCascades(unsigned int count = 2);
+
+    /**
+     * the next search starts in a window around the given region, the 
+     * whole frame is only searched if the eyes are not in the window. 
+     * every found eye pair replaces the hint.
+     * @param region where the eye (or the eyes) has been seen last, in 
+     *  full frame coordinates. an empty Rect searches the whole frame
+     */
+    void setSearchHint(const Rect& region);
+
+    /**
+     * @return the eye pair found last (or the hint given), an empty Rect
+     *  before the first search
+     */
+    Rect getSearchHint() const;
 
     /**
      * Tries to identify the left eye and adjusts 
@@ -63,7 +123,7 @@ public:
     /**
      * Tries to identify the eye and adjusts 
      * the provided eyeRect. The config property
-     * GazeConfig::DETECT_LEFT_EYE determines if 
+     * TrackerConfig::detectLeftEye determines if 
      * the left or right eye will be returned.
      * 
      * @param image Image in which an eye is searched
@@ -71,4 +131,17 @@ public:
      * @return true if the left eye has been found, false otherwise
      */
     bool findEye(Mat &image, Rect& eyeRect);
+
+    /**
+     * Tries to identify both eyes in the same eye 
+     * region and adjusts the provided rects.
+     * 
+     * @param image Image in which the eyes are searched
+     * @param leftEyeRect if found, the region of the left eye
+     * @param rightEyeRect if found, the region of the right eye
+     * @return true if both eyes have been found, false otherwise
+     */
+    bool findEyes(Mat &image, Rect& leftEyeRect, Rect& rightEyeRect);
 };
+
+#endif /* FINDEYEREGION_HPP_ */
@@ -0,0 +1,62 @@
+#include <algorithm>
+
+#include <opencv2/imgproc/imgproc.hpp>
+
+#include "GlintPatternLocator.hpp"
+#include "../glint/FindGlints.hpp"
+#include "../../utils/log.hpp"
+
+using namespace std;
+using namespace cv;
+
+GlintPatternLocator::GlintPatternLocator(const TrackerConfig& config) : config(config) {
+}
+
+void GlintPatternLocator::setConfig(const TrackerConfig& config) {
+    this->config = config;
+}
+
+int GlintPatternLocator::locate(const Mat& frame, vector<Rect>& eyes, int maxEyes) {
+    eyes.clear();
+    const double scale = GazeConfig::GLINT_LOCATOR_SCALE_PERCENT / 100.;
+
+    // a glint of a single pixel is still a (gray) pixel after the scaling
+    Mat glints, small;
+    threshold(frame, glints, config.glintThreshold, 255, THRESH_BINARY);
+    resize(glints, small, Size(), scale, scale, INTER_AREA);
+
+    TrackerConfig smallConfig = config;
+    smallConfig.glintThreshold = 0;
+    smallConfig.glintDistance = cvRound(config.glintDistance * scale);
+    smallConfig.glintDistanceTolerance = cvRound(config.glintDistanceTolerance * scale);
+    FindGlints findGlints(smallConfig);
+
+    const int eyeSize = GazeConfig::GLINT_LOCATOR_EYE_SIZE * config.glintDistance;
+    const int margin = smallConfig.glintDistance;
+    Rect fullFrame(Point(), frame.size());
+
+    for (int eye = 0; eye < maxEyes; ++eye) {
+        vector<Point> glintCenters;
+        Point2f center(lastGlintCenter.x * scale, lastGlintCenter.y * scale);
+        if (!findGlints.findGlints(small, glintCenters, center))
+            break;
+
+        Point2f glintCenter(center.x / scale, center.y / scale);
+        eyes.push_back(Rect(cvRound(glintCenter.x - eyeSize / 2.),
+                cvRound(glintCenter.y - eyeSize / 2.), eyeSize, eyeSize) & fullFrame);
+        if (eye == 0)
+            lastGlintCenter = glintCenter;
+
+        // the next eye is searched without these glints
+        Rect found = boundingRect(glintCenters);
+        found = Rect(found.x - margin, found.y - margin, found.width + 2 * margin,
+                found.height + 2 * margin) & Rect(Point(), small.size());
+        small(found).setTo(Scalar(0));
+    }
+
+    LOG_D("Eyes located by glints: " << eyes.size());
+    if (eyes.size() == 2 && eyes[1].x < eyes[0].x)
+        swap(eyes[0], eyes[1]);
+
+    return eyes.size();
+}
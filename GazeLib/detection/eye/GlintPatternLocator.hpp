@@ -0,0 +1,52 @@
+#ifndef GLINTPATTERNLOCATOR_HPP_
+#define GLINTPATTERNLOCATOR_HPP_
+
+#include <vector>
+
+#include <opencv2/core/core.hpp>
+
+#include "../../config/TrackerConfig.hpp"
+
+/**
+ * The GlintPatternLocator finds the eyes without the haar classifiers. the
+ * illumination always produces 4 rectangularly aligned glints on the
+ * cornea, so a rectangle of bright blobs with the glint geometry is an eye.
+ * <br />the frame is binarized with the glint threshold and scaled to
+ * GazeConfig::GLINT_LOCATOR_SCALE_PERCENT, then a FindGlints with the
+ * scaled glint distance searches the glint rectangles in the small frame.
+ * the proposed eye region is a square of GazeConfig::GLINT_LOCATOR_EYE_SIZE
+ * glint distances around the glints.
+ * <br />this is much cheaper than the cascades, but any glint rectangle is
+ * taken for an eye (e.g. reflections on glasses).
+ * @see TrackerConfig::locateEyesByGlints
+ */
+class GlintPatternLocator {
+private:
+    TrackerConfig config;
+    /// the glint center of the eye found last (in frame coordinates), the
+    /// glints closest to it are found first
+    cv::Point2f lastGlintCenter;
+
+public:
+    /**
+     * @param config the glint threshold and geometry
+     */
+    GlintPatternLocator(const TrackerConfig& config = TrackerConfig());
+
+    /**
+     * @param config the config of the GazeTracker
+     */
+    void setConfig(const TrackerConfig& config);
+
+    /**
+     * searches glint rectangles in the frame
+     * @param frame the gray frame
+     * @param eyes the proposed eye regions in frame coordinates, from the
+     *  left to the right
+     * @param maxEyes the maximum number of eyes to find
+     * @return the number of found eyes
+     */
+    int locate(const cv::Mat& frame, std::vector<cv::Rect>& eyes, int maxEyes = 1);
+};
+
+#endif /* GLINTPATTERNLOCATOR_HPP_ */
@@ -11,6 +11,7 @@
 #include "../../utils/log.hpp"
 #include "../../utils/geometry.hpp"
 #include "../../utils/gui.hpp"
+#include "../../utils/latency.hpp"
 #include "../../config/GazeConfig.hpp"
 
 #if __DEBUG_FINDGLINTS == 1
@@ -20,8 +21,22 @@
 using namespace std;
 using namespace cv;
 
+FindGlints::FindGlints(const TrackerConfig& config) : config(config),
+glintDistance(config.glintDistance) {
+}
+
+void FindGlints::setConfig(const TrackerConfig& config) {
+    this->config = config;
+    glintDistance = config.glintDistance;
+}
+
+int FindGlints::getGlintDistance() const {
+    return glintDistance;
+}
+
 bool FindGlints::findGlints(cv::Mat& frame, vector<cv::Point>& glintCenters,
         cv::Point2f& lastMeasurement) {
+    ScopedTimer timer(STAGE_FIND_GLINTS);
 
     Mat img;
 
@@ -30,7 +45,7 @@ bool FindGlints::findGlints(cv::Mat& frame, vector<cv::Point>& glintCenters,
 #endif
 
     // Threshold image.
-    threshold(frame, img, GazeConfig::GLINT_THRESHOLD, 255,
+    threshold(frame, img, config.glintThreshold, 255,
             cv::THRESH_TOZERO);
 
 #if __DEBUG_FINDGLINTS == 1
@@ -88,7 +103,7 @@ bool FindGlints::findGlints(cv::Mat& frame, vector<cv::Point>& glintCenters,
 
     // Adjust glint distance with current measurement
     // To make sure that the diagonals are also considered, the width of the cluster are multiplied with SQR(2)
-    GazeConfig::GLINT_DISTANCE = 0.8 * GazeConfig::GLINT_DISTANCE + 0.2 * (clusters.at(0).width() * 1.4);
+    glintDistance = 0.8 * glintDistance + 0.2 * (clusters.at(0).width() * 1.4);
 
     glintCenters = clusters.at(0).glintsInCluster();
     lastMeasurement = clusters.at(0).centerPoint();
@@ -116,8 +131,8 @@ cv::Mat FindGlints::distanceMatrix(vector<cv::Point>& glintCenter) {
             int dist = calcPointDistance(&glintCenter.at(i), &glintCenter.at(j));
             // Consider only nighbours within distance
             // There is a tolerance added as well
-            if (dist >= (GazeConfig::GLINT_DISTANCE - GazeConfig::GLINT_DISTANCE_TOLERANCE)
-                    && dist <= (GazeConfig::GLINT_DISTANCE + GazeConfig::GLINT_DISTANCE_TOLERANCE)) {
+            if (dist >= (glintDistance - config.glintDistanceTolerance)
+                    && dist <= (glintDistance + config.glintDistanceTolerance)) {
                 distanceMat.at<char>(i, j) = 1;
             }
         }
@@ -218,7 +233,7 @@ bool FindGlints::findRectangularCluster(vector<cv::Point>& glints) {
     quadruple.push_back(glints.at(comb[1]));
     quadruple.push_back(glints.at(comb[2]));
     quadruple.push_back(glints.at(comb[3]));
-    hasRectangularAlignment = isRectangle(quadruple, GazeConfig::GLINT_ANGLE_TOLERANCE);
+    hasRectangularAlignment = isRectangle(quadruple, config.glintAngleTolerance);
 
     // Generate and print all the other combinations
     while (!hasRectangularAlignment && next_comb(comb, k, n)) {
@@ -227,7 +242,7 @@ bool FindGlints::findRectangularCluster(vector<cv::Point>& glints) {
         quadruple.push_back(glints.at(comb[1]));
         quadruple.push_back(glints.at(comb[2]));
         quadruple.push_back(glints.at(comb[3]));
-        hasRectangularAlignment = isRectangle(quadruple, GazeConfig::GLINT_ANGLE_TOLERANCE);
+        hasRectangularAlignment = isRectangle(quadruple, config.glintAngleTolerance);
     }
 
     LOG_D("isRect: " << hasRectangularAlignment);
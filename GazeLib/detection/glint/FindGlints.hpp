@@ -6,21 +6,41 @@
 #include <opencv2/objdetect/objdetect.hpp>
 
 #include "GlintCluster.hpp"
+#include "../../config/TrackerConfig.hpp"
 
 using namespace std;
 
 /**
  * This class tries to find 4 rectangularly aligned glints
- * 
+ * <br />the expected distance between the glints is adapted to the
+ * measured glints. this state belongs to the instance, so every tracker
+ * needs its own FindGlints.
  */
 class FindGlints {
 private:
+    TrackerConfig config;
+    /// the current distance between two neighboring glints
+    int glintDistance;
+
     cv::Mat distanceMatrix(vector<cv::Point>& glintCenter);
     void findClusters(vector<cv::Point>& blobs, vector<GlintCluster>& clusters,
             cv::Point2f& lastMeasurement);
 
 
 public:
+    FindGlints(const TrackerConfig& config = TrackerConfig());
+
+    /**
+     * replaces the config and restarts the glint distance adaption
+     * @param config the config of the GazeTracker
+     */
+    void setConfig(const TrackerConfig& config);
+
+    /**
+     * @return the current (adapted) distance between two neighboring glints
+     */
+    int getGlintDistance() const;
+
     /**
      * 
      * Tries to find 4 rectangularly aligned glints
@@ -6,9 +6,32 @@
 #include "../../config/GazeConfig.hpp"
 #include "../../utils/geometry.hpp"
 #include "../../utils/gui.hpp"
+#include "../../utils/latency.hpp"
 #include "../../utils/log.hpp"
 
 
+/**
+ * random numbers for std::random_shuffle from the RNG of a Ransac instance.
+ * rand() shares its state with all threads
+ */
+struct ShuffleRandom {
+	cv::RNG& rng;
+
+	ShuffleRandom(cv::RNG& rng) : rng(rng) {
+	}
+
+	int operator()(int n) {
+		return rng.uniform(0, n);
+	}
+};
+
+Ransac::Ransac(const TrackerConfig& config) : iterations(config.ransacIterations) {
+}
+
+void Ransac::setConfig(const TrackerConfig& config) {
+	iterations = config.ransacIterations;
+}
+
 //
 // algorithm:
 // - chose 3 random points
@@ -21,8 +44,10 @@
 //
 bool Ransac::ransac(float * x, float * y, float * radius,
 		std::vector<cv::Point2f> points) {
+	ScopedTimer timer(STAGE_RANSAC);
+
 	// N: num of iterations
-	const int N = GazeConfig::RANSAC_ITERATIONS;
+	const int N = iterations;
 	// T: distance in which
 	const float T = 2;
 
@@ -31,8 +56,7 @@ bool Ransac::ransac(float * x, float * y, float * radius,
 	if(points.size() < 3)
 		return found;
 
-	// initialize randomizer
-	srand(time(NULL));
+	ShuffleRandom random(rng);
 
     std::vector<cv::Point2f> points_in_range;
 
@@ -50,7 +74,7 @@ bool Ransac::ransac(float * x, float * y, float * radius,
         std::vector<cv::Point2f> curr_points_in_range;
 
 		// fit a random circle
-		std::random_shuffle(points.begin(), points.end());
+		std::random_shuffle(points.begin(), points.end(), random);
 		fitCircle(&tmp_x, &tmp_y, &tmp_r, points);
 
 #if __DEBUG_STARBURST == 1
@@ -121,6 +145,7 @@ bool Ransac::ransac(float * x, float * y, float * radius,
     
     // now calculate the circle who fits the points best
     if(found){
+        ScopedTimer fitTimer(STAGE_FIT_CIRCLE);
         bestFitCircle(x, y, radius, points_in_range);
         
 #if __DEBUG_STARBURST == 1
@@ -4,6 +4,8 @@
 #include <vector>
 #include <opencv2/core/core.hpp>
 
+#include "../../config/TrackerConfig.hpp"
+
 /**
  * Implementation of the ransac algorithm
  * 
@@ -14,9 +16,25 @@
  * - use the circle which had the most points within the
  *   range
  * - search for the circle who fits these circles best
+ *
+ * every instance has its own random number generator, so several instances
+ * can be used on different threads. 
  */
 class Ransac {
+private:
+    /// the number of iterations (N)
+    unsigned int iterations;
+    cv::RNG rng;
+
 public:
+    Ransac(const TrackerConfig& config = TrackerConfig());
+
+    /**
+     * takes the number of iterations from the given config
+     * @param config the config of the GazeTracker
+     */
+    void setConfig(const TrackerConfig& config);
+
     /**
      * Fits a circle into a cloud of points
      * 
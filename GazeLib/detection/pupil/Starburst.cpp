@@ -7,6 +7,7 @@
 
 #include "../../utils/log.hpp"
 #include "../../utils/geometry.hpp"
+#include "../../utils/latency.hpp"
 
 using namespace cv;
 using namespace std;
@@ -19,7 +20,7 @@ using namespace std;
 #include <opencv2/features2d/features2d.hpp>
 #endif
 
-Starburst::Starburst() {
+Starburst::Starburst(const TrackerConfig& config) : ransac(config), config(config) {
 
 	// pre calculate the sin/cos values
 	float angle_delta = 1 * PI / 180;
@@ -32,6 +33,11 @@ Starburst::Starburst() {
 
 }
 
+void Starburst::setConfig(const TrackerConfig& config) {
+	this->config = config;
+	ransac.setConfig(config);
+}
+
 /*
  * idea: only use the precalculated rectangle.
  * - remove the glints, 
@@ -46,9 +52,15 @@ bool Starburst::findPupil(cv::Mat& frame, vector<cv::Point> glint_centers,
 	bool found = false;
 	Point2f startpoint(glintcenter.x,glintcenter.y);
 
-	remove_glints(working_frame, glint_centers, GazeConfig::GLINT_RADIUS);
-	medianBlur(working_frame, working_frame, 5);
-	found = starburst(working_frame, startpoint, radius, 20);
+	{
+		ScopedTimer timer(STAGE_REMOVE_GLINTS);
+		remove_glints(working_frame, glint_centers, GazeConfig::GLINT_RADIUS);
+	}
+	{
+		ScopedTimer timer(STAGE_MEDIAN_BLUR);
+		medianBlur(working_frame, working_frame, 5);
+	}
+	found = starburst(working_frame, startpoint, radius, config.starburstRays);
 
 	// display the center on the source image
 	if (found)
@@ -171,7 +183,9 @@ bool Starburst::starburst(cv::Mat &gray, Point2f &center, float &radius,
 
     const int LINE_LENGTH=150;
     
-	for(unsigned short iterations = 0; iterations < GazeConfig::MAX_STARBURST_ITERATIONS; ++iterations){
+    ScopedTimer timer(STAGE_STARBURST);
+
+	for(unsigned short iterations = 0; iterations < config.starburstIterations; ++iterations){
 
 		points.clear();
         
@@ -181,7 +195,7 @@ bool Starburst::starburst(cv::Mat &gray, Point2f &center, float &radius,
 			const double current_angle = angle * angleNum;
             
             Point2f edgePoint;
-            bool success = followRay(gray, start_point, current_angle, edgePoint, LINE_LENGTH, GazeConfig::STARBURST_EDGE_THRESHOLD);
+            bool success = followRay(gray, start_point, current_angle, edgePoint, LINE_LENGTH, config.starburstEdgeThreshold);
             
             if(success){
                 points.push_back(edgePoint);
@@ -193,7 +207,7 @@ bool Starburst::starburst(cv::Mat &gray, Point2f &center, float &radius,
                 while(new_angle < target_angle){
                     Point2f new_edge;
                     bool success = followRay(gray, edgePoint, new_angle, 
-                                    new_edge, LINE_LENGTH / 4, GazeConfig::STARBURST_EDGE_THRESHOLD);
+                                    new_edge, LINE_LENGTH / 4, config.starburstEdgeThreshold);
                     
                     if(success)
                         points.push_back(new_edge);
@@ -231,6 +245,7 @@ bool Starburst::starburst(cv::Mat &gray, Point2f &center, float &radius,
 		start_point.y = mean_y;
 
 	}
+	timer.stop(); // RANSAC is timed on its own
 
 	// we didn't find a center within the
 	// max iterations!
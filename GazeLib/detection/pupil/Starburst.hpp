@@ -5,6 +5,7 @@
 #include <opencv2/core/core.hpp>
 
 #include "Ransac.hpp"
+#include "../../config/TrackerConfig.hpp"
 
 /**
  * Implementation of the Startburst algorithm
@@ -20,13 +21,20 @@ private:
 	double cos_array[angle_num];
     
     Ransac ransac;
+    TrackerConfig config;
 
 public:
-	Starburst();
+	Starburst(const TrackerConfig& config = TrackerConfig());
+
+    /**
+     * replaces the config (and the config of the Ransac)
+     * @param config the config of the GazeTracker
+     */
+    void setConfig(const TrackerConfig& config);
     
     /**
      * finds the pupil center and radius using the starburst algorithm
-     * @see GazeConfig::STARBURST_EDGE_THRESHOLD
+     * @see TrackerConfig::starburstEdgeThreshold, TrackerConfig::starburstRays
      * 
      * @param image the image to search the pupil (MUST BE A GRAYSCALE IMAGE)
      * @param glint_centers the centers of the glints inside the image (if any)
@@ -0,0 +1,217 @@
+#include <algorithm>
+#include <cmath>
+
+#include "GazeFilter.hpp"
+
+using namespace std;
+using namespace cv;
+
+/// the time between two samples if the capture times are unknown (30 fps)
+static const double DEFAULT_SAMPLE_PERIOD = 1.0 / 30;
+/// scales the median absolute deviation to the standard deviation
+static const float MAD_TO_SIGMA = 1.4826f;
+
+static double samplePeriod(bool hasSample, double lastTime, double time) {
+    if (!hasSample || time <= lastTime)
+        return DEFAULT_SAMPLE_PERIOD;
+    return time - lastTime;
+}
+
+//
+// BoxFilter
+//
+
+BoxFilter::BoxFilter(unsigned int numOfSamples) :
+samples(numOfSamples > 0 ? numOfSamples : 1), count(0), next(0) {
+}
+
+Point2f BoxFilter::filter(const Point2f& measured, double time) {
+    // the oldest sample leaves the window
+    if (count == samples.size())
+        sum -= samples[next];
+    else
+        ++count;
+
+    samples[next] = measured;
+    sum += measured;
+    next = (next + 1) % samples.size();
+
+    // the running sum collects rounding errors, it is summed up anew once
+    // per window
+    if (next == 0) {
+        sum = Point2f();
+        for (unsigned int i = 0; i < count; ++i)
+            sum += samples[i];
+    }
+
+    return sum * (1.0 / count);
+}
+
+void BoxFilter::reset() {
+    sum = Point2f();
+    count = 0;
+    next = 0;
+}
+
+//
+// OneEuroFilter
+//
+
+/// the smoothing factor of a low pass filter with the given cutoff frequency
+static double smoothingFactor(double cutoff, double period) {
+    double tau = 1.0 / (2 * CV_PI * cutoff);
+    return 1.0 / (1.0 + tau / period);
+}
+
+OneEuroFilter::OneEuroFilter(double minCutoff, double beta, double derivativeCutoff) :
+minCutoff(minCutoff), beta(beta), derivativeCutoff(derivativeCutoff),
+hasSample(false), lastTime(0) {
+}
+
+Point2f OneEuroFilter::filter(const Point2f& measured, double time) {
+    if (!hasSample) {
+        hasSample = true;
+        lastTime = time;
+        lastFiltered = measured;
+        lastDerivative = Point2f();
+        return measured;
+    }
+
+    double period = samplePeriod(hasSample, lastTime, time);
+    lastTime = time;
+
+    // the smoothed speed of the signal
+    Point2f derivative = (measured - lastFiltered) * (1.0 / period);
+    double derivativeAlpha = smoothingFactor(derivativeCutoff, period);
+    lastDerivative = lastDerivative + (derivative - lastDerivative) * derivativeAlpha;
+
+    // the faster the signal, the higher the cutoff frequency
+    double cutoff = minCutoff + beta * norm(lastDerivative);
+    double alpha = smoothingFactor(cutoff, period);
+    lastFiltered = lastFiltered + (measured - lastFiltered) * alpha;
+
+    return lastFiltered;
+}
+
+void OneEuroFilter::reset() {
+    hasSample = false;
+}
+
+//
+// KalmanGazeFilter
+//
+
+KalmanGazeFilter::KalmanGazeFilter(float accelerationNoise, float measurementNoise) :
+kalman(4, 2, 0, CV_32F), measurement(2, 1, CV_32F),
+accelerationNoise(accelerationNoise), hasSample(false), lastTime(0) {
+    setIdentity(kalman.transitionMatrix);
+    setIdentity(kalman.measurementMatrix);
+    setIdentity(kalman.measurementNoiseCov, Scalar(measurementNoise));
+}
+
+Point2f KalmanGazeFilter::filter(const Point2f& measured, double time) {
+    measurement.at<float>(0) = measured.x;
+    measurement.at<float>(1) = measured.y;
+
+    if (!hasSample) {
+        // start at the first sample, the velocity is unknown
+        kalman.statePost = Mat::zeros(4, 1, CV_32F);
+        kalman.statePost.at<float>(0) = measured.x;
+        kalman.statePost.at<float>(1) = measured.y;
+        setIdentity(kalman.errorCovPost, Scalar(accelerationNoise * DEFAULT_SAMPLE_PERIOD));
+        hasSample = true;
+        lastTime = time;
+        return measured;
+    }
+
+    float dt = samplePeriod(hasSample, lastTime, time);
+    lastTime = time;
+
+    kalman.transitionMatrix.at<float>(0, 2) = dt;
+    kalman.transitionMatrix.at<float>(1, 3) = dt;
+
+    // a random acceleration during dt
+    float q = accelerationNoise;
+    kalman.processNoiseCov = Mat::zeros(4, 4, CV_32F);
+    for (int i = 0; i < 2; ++i) {
+        kalman.processNoiseCov.at<float>(i, i) = q * dt * dt * dt / 3;
+        kalman.processNoiseCov.at<float>(i, i + 2) = q * dt * dt / 2;
+        kalman.processNoiseCov.at<float>(i + 2, i) = q * dt * dt / 2;
+        kalman.processNoiseCov.at<float>(i + 2, i + 2) = q * dt;
+    }
+
+    kalman.predict();
+    const Mat& state = kalman.correct(measurement);
+
+    return Point2f(state.at<float>(0), state.at<float>(1));
+}
+
+void KalmanGazeFilter::reset() {
+    hasSample = false;
+}
+
+//
+// HampelFilter
+//
+
+HampelFilter::HampelFilter(unsigned int windowSize, float threshold,
+        GazeFilter *nextFilter) : samples(windowSize > 0 ? windowSize : 1),
+count(0), next(0), threshold(threshold), nextFilter(nextFilter) {
+    values.reserve(samples.size());
+}
+
+float HampelFilter::median(bool xAxis) {
+    values.clear();
+    for (unsigned int i = 0; i < count; ++i)
+        values.push_back(xAxis ? samples[i].x : samples[i].y);
+
+    vector<float>::iterator middle = values.begin() + values.size() / 2;
+    nth_element(values.begin(), middle, values.end());
+    return *middle;
+}
+
+float HampelFilter::medianAbsoluteDeviation(bool xAxis, float median) {
+    values.clear();
+    for (unsigned int i = 0; i < count; ++i)
+        values.push_back(fabs((xAxis ? samples[i].x : samples[i].y) - median));
+
+    vector<float>::iterator middle = values.begin() + values.size() / 2;
+    nth_element(values.begin(), middle, values.end());
+    return *middle;
+}
+
+Point2f HampelFilter::filter(const Point2f& measured, double time) {
+    // the window keeps the measured samples, outliers included
+    samples[next] = measured;
+    next = (next + 1) % samples.size();
+    if (count < samples.size())
+        ++count;
+
+    Point2f accepted = measured;
+
+    // there is no median of one or two samples
+    if (count >= 3) {
+        float medianX = median(true);
+        float medianY = median(false);
+        float sigmaX = MAD_TO_SIGMA * medianAbsoluteDeviation(true, medianX);
+        float sigmaY = MAD_TO_SIGMA * medianAbsoluteDeviation(false, medianY);
+
+        if (fabs(measured.x - medianX) > threshold * sigmaX)
+            accepted.x = medianX;
+        if (fabs(measured.y - medianY) > threshold * sigmaY)
+            accepted.y = medianY;
+    }
+
+    if (nextFilter != NULL)
+        return nextFilter->filter(accepted, time);
+
+    return accepted;
+}
+
+void HampelFilter::reset() {
+    count = 0;
+    next = 0;
+
+    if (nextFilter != NULL)
+        nextFilter->reset();
+}
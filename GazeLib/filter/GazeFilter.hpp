@@ -0,0 +1,157 @@
+#ifndef GAZEFILTER_HPP_
+#define GAZEFILTER_HPP_
+
+#include <vector>
+
+#include <opencv2/core/core.hpp>
+#include <opencv2/video/tracking.hpp>
+
+#include "../config/GazeConfig.hpp"
+
+/**
+ * a GazeFilter smooths the measured GazeVectors of a GazeTracker. the
+ * filters work incrementally, every sample takes the same (small) amount
+ * of work no matter how long the tracking runs.
+ * <br />a filter keeps the state of one gaze signal, every GazeTracker needs
+ * its own instance.
+ * @see GazeTracker::setGazeFilter()
+ */
+class GazeFilter {
+public:
+
+    virtual ~GazeFilter() {
+    }
+
+    /**
+     * filters the next GazeVector
+     * @param measured the measured GazeVector
+     * @param time the capture time of the frame in seconds
+     * @return the filtered GazeVector
+     */
+    virtual cv::Point2f filter(const cv::Point2f& measured, double time) = 0;
+
+    /**
+     * forgets all samples, e.g. after the eye has been searched again
+     */
+    virtual void reset() = 0;
+};
+
+/**
+ * the moving average of the last samples. the sum of the samples is kept,
+ * so a sample costs the same for every window size.
+ * <br />this is the default filter of the GazeTracker
+ */
+class BoxFilter : public GazeFilter {
+private:
+    std::vector<cv::Point2f> samples;
+    cv::Point2f sum;
+    /// the number of samples in the window
+    unsigned int count;
+    /// the index of the next sample
+    unsigned int next;
+
+public:
+    /**
+     * @param numOfSamples the size of the window
+     */
+    BoxFilter(unsigned int numOfSamples = GazeConfig::NUM_OF_SMOOTHING_FRAMES);
+
+    cv::Point2f filter(const cv::Point2f& measured, double time);
+    void reset();
+};
+
+/**
+ * the One Euro Filter (Casiez et al.) is a low pass filter whose cutoff
+ * frequency rises with the speed of the signal: fixations are smoothed a
+ * lot, saccades are followed with little lag.
+ */
+class OneEuroFilter : public GazeFilter {
+private:
+    double minCutoff;
+    double beta;
+    double derivativeCutoff;
+
+    bool hasSample;
+    double lastTime;
+    cv::Point2f lastFiltered;
+    cv::Point2f lastDerivative;
+
+public:
+    /**
+     * @param minCutoff the cutoff frequency (Hz) while the gaze is still.
+     *  lower values smooth the fixations more
+     * @param beta how fast the cutoff frequency rises with the speed (in
+     *  GazeVector pixels per second). higher values reduce the lag
+     * @param derivativeCutoff the cutoff frequency (Hz) of the speed
+     */
+    OneEuroFilter(double minCutoff = 1.0, double beta = 0.05, double derivativeCutoff = 1.0);
+
+    cv::Point2f filter(const cv::Point2f& measured, double time);
+    void reset();
+};
+
+/**
+ * a constant velocity kalman filter. the time between two samples is taken
+ * from the capture times, dropped frames are no problem.
+ */
+class KalmanGazeFilter : public GazeFilter {
+private:
+    /// state: x, y, vx, vy, measurement: x, y
+    cv::KalmanFilter kalman;
+    cv::Mat measurement;
+    float accelerationNoise;
+    bool hasSample;
+    double lastTime;
+
+public:
+    /**
+     * @param accelerationNoise the variance of the acceleration of the
+     *  GazeVector ((pixels per second^2)^2). higher values reduce the lag
+     * @param measurementNoise the variance of a measured GazeVector (pixels^2)
+     */
+    KalmanGazeFilter(float accelerationNoise = 20000, float measurementNoise = 1);
+
+    cv::Point2f filter(const cv::Point2f& measured, double time);
+    void reset();
+};
+
+/**
+ * the Hampel Filter replaces outliers (e.g. a wrong pupil) with the median of
+ * the last samples. a sample is an outlier if it is further away from the
+ * median than a few median absolute deviations.
+ * <br />the other samples are passed on unchanged, or to the next filter to
+ * smooth them.
+ * <br />every sample costs O(windowSize): the medians are selected anew from
+ * the window. the window is small (a few samples), this is cheaper than
+ * keeping the window sorted.
+ */
+class HampelFilter : public GazeFilter {
+private:
+    std::vector<cv::Point2f> samples;
+    unsigned int count;
+    unsigned int next;
+    float threshold;
+    GazeFilter *nextFilter;
+
+    /// scratch space for the median
+    std::vector<float> values;
+
+    float median(bool xAxis);
+    float medianAbsoluteDeviation(bool xAxis, float median);
+
+public:
+    /**
+     * @param windowSize the number of samples the median is taken of
+     * @param threshold the number of standard deviations (estimated with the
+     *  median absolute deviation) a sample may differ from the median
+     * @param nextFilter an optional filter which gets the samples without
+     *  the outliers. the HampelFilter does not take the ownership.
+     */
+    HampelFilter(unsigned int windowSize = 7, float threshold = 3,
+            GazeFilter *nextFilter = NULL);
+
+    cv::Point2f filter(const cv::Point2f& measured, double time);
+    void reset();
+};
+
+#endif /* GAZEFILTER_HPP_ */
@@ -0,0 +1,94 @@
+#ifndef GAZESTREAMFORMAT_HPP_
+#define GAZESTREAMFORMAT_HPP_
+
+#include <stdint.h>
+
+/**
+ * The gaze stream is a ring buffer of gaze samples in POSIX shared memory.
+ * one GazeStreamWriter (the gaze service) publishes the samples, any number
+ * of GazeStreamReaders in other processes map the same memory and read them
+ * without system calls. the writer never waits for the readers: a reader
+ * which is too slow misses the overwritten samples.
+ * <br />the shared memory object consists of
+ * <ul>
+ *  <li>a GazeStreamHeader</li>
+ *  <li>GazeStreamHeader::capacity GazeStreamSamples</li>
+ * </ul>
+ * every sample carries a version (a sequence lock): it is odd while the
+ * writer changes the sample, 2 * (n + 1) once the sample number n has been
+ * written. a reader copies the sample and checks that the version has not
+ * changed in the meantime.
+ * <br />all timestamps are microseconds of CLOCK_MONOTONIC, they can be
+ * compared between the processes of a machine.
+ * @see GazeStreamWriter
+ * @see GazeStreamReader
+ */
+
+/// the magic bytes at the beginning of the shared memory
+#define GAZE_STREAM_MAGIC "GAZESHM"
+/// the version of the layout
+#define GAZE_STREAM_VERSION 1
+/// the name of the shared memory object of the gaze service
+#define GAZE_STREAM_DEFAULT_NAME "/gazelib-stream"
+
+/**
+ * the state of the gaze service
+ */
+enum GazeStreamStatus {
+    /// the service is opening the camera
+    STREAM_STARTING,
+    /// the eye region is searched, no samples are published
+    STREAM_SEARCHING,
+    /// the eye is tracked, a sample is published per frame
+    STREAM_TRACKING,
+    /// the service has stopped
+    STREAM_STOPPED,
+    /// the service has stopped because of an error (e.g. no camera)
+    STREAM_FAILED,
+};
+
+struct GazeStreamSample {
+    /// the sequence lock, see above
+    volatile uint64_t version;
+    /// the sequence number of the frame
+    uint64_t sequenceNumber;
+    /// the capture time of the frame
+    int64_t captureMicros;
+    /// the time when the GazeVector has been measured (0 if not measured)
+    int64_t measureMicros;
+    /// a MeasureResult, the GazeVector is only valid if it is MEASURE_OK (0)
+    int32_t result;
+    /// the smoothed GazeVector
+    float gazeX;
+    float gazeY;
+    /// between 0 and 1, @see FrameResult::confidence
+    float confidence;
+    /// the pupil in full frame coordinates
+    float pupilX;
+    float pupilY;
+    float pupilRadius;
+    /// the glint center in full frame coordinates
+    float glintX;
+    float glintY;
+};
+
+struct GazeStreamHeader {
+    char magic[8];
+    uint32_t version;
+    /// the number of samples in the ring
+    uint32_t capacity;
+    /// the process id of the writer
+    int32_t writerPid;
+    /// a GazeStreamStatus
+    volatile int32_t status;
+    /// the number of samples published so far, the sample number n is
+    /// stored at n % capacity
+    volatile uint64_t published;
+    /// the number of frames the camera dropped so far
+    volatile uint64_t droppedFrames;
+    /// updated with every frame (and every status change), readers can tell
+    /// a hanging writer from a slow camera
+    volatile int64_t heartbeatMicros;
+};
+
+#endif /* GAZESTREAMFORMAT_HPP_ */
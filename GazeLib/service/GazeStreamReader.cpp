@@ -0,0 +1,140 @@
+#include <cstring>
+#include <ctime>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "GazeStreamReader.hpp"
+#include "../exception/GazeExceptions.hpp"
+
+using namespace std;
+
+/// how often waitForNext() looks for a new sample
+static const unsigned int POLL_INTERVAL_MICROS = 500;
+
+GazeStreamReader::GazeStreamReader(const string& name) : mappingSize(0),
+header(NULL), samples(NULL), position(0), missed(0) {
+
+    int fd = shm_open(name.c_str(), O_RDONLY, 0);
+    if (fd < 0)
+        throw GazeException("The gaze service is not running: " + name);
+
+    struct stat fileStat;
+    void *addr = MAP_FAILED;
+    if (fstat(fd, &fileStat) == 0 && (size_t) fileStat.st_size >= sizeof (GazeStreamHeader)) {
+        mappingSize = fileStat.st_size;
+        addr = mmap(NULL, mappingSize, PROT_READ, MAP_SHARED, fd, 0);
+    }
+    close(fd);
+
+    if (addr == MAP_FAILED)
+        throw GazeException("Could not map the gaze stream " + name);
+
+    header = static_cast<const GazeStreamHeader*> (addr);
+    samples = reinterpret_cast<const GazeStreamSample*> (header + 1);
+
+    // the writer sets the magic after the rest of the header
+    bool valid = strncmp(header->magic, GAZE_STREAM_MAGIC, sizeof (header->magic)) == 0;
+    __sync_synchronize();
+    valid = valid && header->version == GAZE_STREAM_VERSION && header->capacity > 0
+            && sizeof (GazeStreamHeader) + header->capacity * sizeof (GazeStreamSample) <= mappingSize;
+
+    if (!valid) {
+        munmap(const_cast<GazeStreamHeader*> (header), mappingSize);
+        throw GazeException("Not a valid gaze stream: " + name);
+    }
+
+    position = header->published;
+}
+
+GazeStreamReader::~GazeStreamReader() {
+    munmap(const_cast<GazeStreamHeader*> (header), mappingSize);
+}
+
+bool GazeStreamReader::read(uint64_t number, GazeStreamSample& sample) const {
+    const GazeStreamSample& slot = samples[number % header->capacity];
+    const uint64_t written = 2 * (number + 1);
+
+    if (slot.version != written)
+        return false;
+    __sync_synchronize();
+
+    memcpy(&sample, (const void*) &slot, sizeof (GazeStreamSample));
+
+    // the writer may have started to overwrite the sample while we copied it
+    __sync_synchronize();
+    return slot.version == written;
+}
+
+bool GazeStreamReader::next(GazeStreamSample& sample) {
+    uint64_t published = header->published;
+
+    // the oldest samples have been overwritten already
+    if (published - position > header->capacity) {
+        missed += published - header->capacity - position;
+        position = published - header->capacity;
+    }
+
+    while (position < published) {
+        if (read(position++, sample))
+            return true;
+
+        // overwritten while we were reading
+        ++missed;
+    }
+
+    return false;
+}
+
+bool GazeStreamReader::waitForNext(GazeStreamSample& sample, unsigned int timeoutMillis) {
+    int64_t deadline = nowMicros() + timeoutMillis * (int64_t) 1000;
+
+    while (!next(sample)) {
+        if (nowMicros() >= deadline)
+            return false;
+        usleep(POLL_INTERVAL_MICROS);
+    }
+
+    return true;
+}
+
+bool GazeStreamReader::latest(GazeStreamSample& sample) {
+    uint64_t published = header->published;
+    if (position >= published)
+        return false;
+
+    // the newest sample may be overwritten while we read it (very slow reader)
+    for (uint64_t number = published; number > position; --number) {
+        if (read(number - 1, sample)) {
+            position = published;
+            return true;
+        }
+    }
+
+    position = published;
+    return false;
+}
+
+GazeStreamStatus GazeStreamReader::status() const {
+    return (GazeStreamStatus) header->status;
+}
+
+unsigned long GazeStreamReader::droppedFrames() const {
+    return header->droppedFrames;
+}
+
+unsigned long GazeStreamReader::missedSamples() const {
+    return missed;
+}
+
+int64_t GazeStreamReader::heartbeatAgeMicros() const {
+    return nowMicros() - header->heartbeatMicros;
+}
+
+int64_t GazeStreamReader::nowMicros() {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec * (int64_t) 1000000 + now.tv_nsec / 1000;
+}
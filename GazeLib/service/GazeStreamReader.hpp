@@ -0,0 +1,103 @@
+#ifndef GAZESTREAMREADER_HPP_
+#define GAZESTREAMREADER_HPP_
+
+#include <string>
+
+#include "GazeStreamFormat.hpp"
+
+/**
+ * The GazeStreamReader reads the gaze samples published by the gaze service
+ * (a GazeStreamWriter in another process). the shared memory is mapped read
+ * only, reading a sample is a copy of a few bytes without system calls and
+ * the writer never waits for a reader.
+ * <br />the reader does not depend on OpenCV, clients only need this class,
+ * GazeStreamFormat.hpp and the GazeException.
+ * <br />every reader keeps its own position, any number of readers can read
+ * the same stream. a reader which falls more than the capacity of the ring
+ * behind skips the overwritten samples and counts them as missed.
+ *
+ * usage:
+ * <pre>
+ * GazeStreamReader reader;
+ * GazeStreamSample sample;
+ * while (reader.waitForNext(sample, 1000)) {
+ *     if (sample.result == 0)
+ *         cout << sample.gazeX << " " << sample.gazeY << endl;
+ * }
+ * </pre>
+ */
+class GazeStreamReader {
+private:
+    size_t mappingSize;
+    const GazeStreamHeader *header;
+    const GazeStreamSample *samples;
+    /// the number of the next sample to read
+    uint64_t position;
+    unsigned long missed;
+
+    bool read(uint64_t number, GazeStreamSample& sample) const;
+
+    GazeStreamReader(const GazeStreamReader&);
+    GazeStreamReader& operator=(const GazeStreamReader&);
+public:
+    /**
+     * opens the stream. the reader starts with the next published sample
+     * @param name the name of the shared memory object
+     * @throws GazeException if there is no (valid) stream of this name
+     */
+    GazeStreamReader(const std::string& name = GAZE_STREAM_DEFAULT_NAME);
+    ~GazeStreamReader();
+
+    /**
+     * reads the next sample if it has been published already
+     * @param sample the next sample
+     * @return false if there is no new sample
+     */
+    bool next(GazeStreamSample& sample);
+
+    /**
+     * like next(), but waits for the next sample
+     * @param sample the next sample
+     * @param timeoutMillis the maximum time to wait
+     * @return false if no sample has been published within the timeout
+     */
+    bool waitForNext(GazeStreamSample& sample, unsigned int timeoutMillis);
+
+    /**
+     * reads the newest sample and skips the older ones (they are not
+     * counted as missed)
+     * @param sample the newest sample
+     * @return false if there is no new sample
+     */
+    bool latest(GazeStreamSample& sample);
+
+    /**
+     * @return the current GazeStreamStatus of the service
+     */
+    GazeStreamStatus status() const;
+
+    /**
+     * @return the number of frames the camera of the service dropped
+     */
+    unsigned long droppedFrames() const;
+
+    /**
+     * @return the number of samples which have been overwritten before this
+     *  reader has read them
+     */
+    unsigned long missedSamples() const;
+
+    /**
+     * @return the microseconds since the service has published a sample or
+     *  changed its status
+     */
+    int64_t heartbeatAgeMicros() const;
+
+    /**
+     * @return the current time in microseconds of CLOCK_MONOTONIC, the
+     *  clock of all timestamps in the stream
+     */
+    static int64_t nowMicros();
+};
+
+#endif /* GAZESTREAMREADER_HPP_ */
@@ -0,0 +1,164 @@
+#include <cerrno>
+#include <cstring>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "GazeStreamWriter.hpp"
+#include "../exception/GazeExceptions.hpp"
+
+using namespace std;
+using namespace cv;
+
+/**
+ * the ticks of cv::getTickCount() are taken from CLOCK_MONOTONIC, so the
+ * readers can compare the timestamps with their own clock
+ */
+static int64_t toMicros(int64 ticks) {
+    return (int64_t) (ticks * (1e6 / getTickFrequency()));
+}
+
+/**
+ * creates the shared memory object of the stream and locks it. the lock is
+ * held as long as the writer lives and released by the kernel however the
+ * writer ends, so an existing stream whose lock is free has been left 
+ * behind (e.g. by a crashed service) and is replaced.
+ * @param name the name of the shared memory object
+ * @return the locked descriptor of the new, empty object
+ * @throws GazeException if another writer holds the lock
+ */
+static int createLockedStream(const string& name) {
+    while (true) {
+        int fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+        bool created = fd >= 0;
+        if (!created) {
+            if (errno != EEXIST)
+                throw GazeException("Could not create the gaze stream " + name);
+            fd = shm_open(name.c_str(), O_RDWR, 0);
+            if (fd < 0 && errno == ENOENT)
+                continue; // removed meanwhile
+            if (fd < 0)
+                throw GazeException("Could not open the gaze stream " + name);
+        }
+
+        // a new object may already be locked by a writer which checks it
+        if (flock(fd, LOCK_EX | LOCK_NB) != 0) {
+            close(fd);
+            throw GazeException("The gaze stream is already written by another process: " + name);
+        }
+
+        // the object has been replaced while we waited for its lock
+        struct stat fileStat;
+        if (fstat(fd, &fileStat) != 0 || fileStat.st_nlink == 0) {
+            close(fd);
+            continue;
+        }
+
+        if (created)
+            return fd;
+
+        // nobody writes the existing stream. the name is removed while we
+        // hold the lock, so no other writer removes it at the same time
+        shm_unlink(name.c_str());
+        close(fd);
+    }
+}
+
+GazeStreamWriter::GazeStreamWriter(const string& name, unsigned int capacity) :
+name(name), fd(-1), mappingSize(0), header(NULL), samples(NULL) {
+    if (capacity == 0)
+        throw WrongArgumentException("The gaze stream needs space for samples");
+
+    // a stream left behind by a crashed writer is replaced, the stream of a
+    // running writer is not taken over
+    fd = createLockedStream(name);
+
+    mappingSize = sizeof (GazeStreamHeader) + capacity * sizeof (GazeStreamSample);
+    void *addr = MAP_FAILED;
+    if (ftruncate(fd, mappingSize) == 0)
+        addr = mmap(NULL, mappingSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+
+    if (addr == MAP_FAILED) {
+        unmap();
+        throw GazeException("Could not map the gaze stream " + name);
+    }
+
+    // the new memory is zeroed: every sample has the version 0 (never written)
+    header = static_cast<GazeStreamHeader*> (addr);
+    samples = reinterpret_cast<GazeStreamSample*> (header + 1);
+
+    header->version = GAZE_STREAM_VERSION;
+    header->capacity = capacity;
+    header->writerPid = getpid();
+    header->status = STREAM_STARTING;
+    header->heartbeatMicros = toMicros(getTickCount());
+
+    // the readers check the magic last
+    __sync_synchronize();
+    strncpy(header->magic, GAZE_STREAM_MAGIC, sizeof (header->magic));
+}
+
+GazeStreamWriter::~GazeStreamWriter() {
+    if (header->status != STREAM_FAILED)
+        setStatus(STREAM_STOPPED);
+    unmap();
+}
+
+void GazeStreamWriter::unmap() {
+    if (header != NULL)
+        munmap(header, mappingSize);
+    header = NULL;
+    samples = NULL;
+
+    // the name is removed before the lock is given up, it is still ours
+    shm_unlink(name.c_str());
+    if (fd >= 0)
+        close(fd);
+    fd = -1;
+}
+
+void GazeStreamWriter::publish(const FrameResult& frameResult) {
+    uint64_t number = header->published;
+    GazeStreamSample& sample = samples[number % header->capacity];
+
+    // odd: the sample is changing
+    sample.version = 2 * number + 1;
+    __sync_synchronize();
+
+    sample.sequenceNumber = frameResult.frameInfo.sequenceNumber;
+    sample.captureMicros = toMicros(frameResult.frameInfo.captureTick);
+    sample.measureMicros = toMicros(frameResult.frameInfo.measureTick);
+    sample.result = frameResult.result;
+    sample.gazeX = frameResult.gazeVector.x;
+    sample.gazeY = frameResult.gazeVector.y;
+    sample.confidence = frameResult.confidence;
+    sample.pupilX = frameResult.pupilCenter.x;
+    sample.pupilY = frameResult.pupilCenter.y;
+    sample.pupilRadius = frameResult.pupilRadius;
+    sample.glintX = frameResult.glintCenter.x;
+    sample.glintY = frameResult.glintCenter.y;
+
+    __sync_synchronize();
+    sample.version = 2 * (number + 1);
+    __sync_synchronize();
+
+    header->published = number + 1;
+    header->status = STREAM_TRACKING;
+    header->heartbeatMicros = toMicros(getTickCount());
+}
+
+void GazeStreamWriter::setStatus(GazeStreamStatus status) {
+    header->status = status;
+    header->heartbeatMicros = toMicros(getTickCount());
+}
+
+void GazeStreamWriter::setDroppedFrames(unsigned long droppedFrames) {
+    header->droppedFrames = droppedFrames;
+}
+
+unsigned long GazeStreamWriter::published() const {
+    return header->published;
+}
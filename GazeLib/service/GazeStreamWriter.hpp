@@ -0,0 +1,83 @@
+#ifndef GAZESTREAMWRITER_HPP_
+#define GAZESTREAMWRITER_HPP_
+
+#include <string>
+
+#include "GazeStreamFormat.hpp"
+#include "../detection/FrameResult.hpp"
+
+/**
+ * The GazeStreamWriter creates the shared memory of a gaze stream and
+ * publishes the results of a GazeTracker into it. publishing a sample only
+ * writes a few bytes to memory, it can be done in the TrackerCallback.
+ * <br />there is only one writer per stream. the writer holds a lock (flock)
+ * on the shared memory as long as it lives. an existing stream of the same
+ * name is only replaced if nobody holds its lock (e.g. it has been left
+ * behind by a crashed service), readers which still map it have to reopen
+ * the stream.
+ *
+ * usage:
+ * <pre>
+ * GazeStreamWriter stream;
+ * stream.setStatus(STREAM_SEARCHING);
+ * ...
+ * bool frameProcessed(FrameResult &frameResult) {
+ *     stream.publish(frameResult);
+ * }
+ * </pre>
+ * @see GazeStreamReader
+ */
+class GazeStreamWriter {
+private:
+    std::string name;
+    /// the shared memory object, it is locked while the writer lives
+    int fd;
+    size_t mappingSize;
+    GazeStreamHeader *header;
+    GazeStreamSample *samples;
+
+    void unmap();
+
+    GazeStreamWriter(const GazeStreamWriter&);
+    GazeStreamWriter& operator=(const GazeStreamWriter&);
+public:
+    /**
+     * creates the shared memory
+     * @param name the name of the shared memory object (starts with a slash)
+     * @param capacity the number of samples in the ring. readers which fall
+     *  further behind miss samples
+     * @throws GazeException if the shared memory could not be created or
+     *  another writer holds the lock of the stream
+     */
+    GazeStreamWriter(const std::string& name = GAZE_STREAM_DEFAULT_NAME,
+            unsigned int capacity = 1024);
+
+    /**
+     * sets the status to STREAM_STOPPED (unless it has failed) and removes
+     * the name of the shared memory. readers keep their mapping.
+     */
+    ~GazeStreamWriter();
+
+    /**
+     * publishes the next sample
+     * @param frameResult the measurements of a frame
+     */
+    void publish(const FrameResult& frameResult);
+
+    /**
+     * @param status the new GazeStreamStatus
+     */
+    void setStatus(GazeStreamStatus status);
+
+    /**
+     * @param droppedFrames the number of frames the camera dropped so far
+     */
+    void setDroppedFrames(unsigned long droppedFrames);
+
+    /**
+     * @return the number of samples published so far
+     */
+    unsigned long published() const;
+};
+
+#endif /* GAZESTREAMWRITER_HPP_ */
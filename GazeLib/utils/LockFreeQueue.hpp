@@ -0,0 +1,151 @@
+#ifndef LOCKFREEQUEUE_HPP_
+#define LOCKFREEQUEUE_HPP_
+
+#include <vector>
+
+#include "threads.hpp"
+
+/**
+ * a bounded first-in first-out queue connecting exactly one producer thread
+ * with one consumer thread. unlike the SpscQueue the producer never waits:
+ * tryPush() fails if the queue is full and takes no lock while the consumer
+ * is busy. the items are kept in a ring buffer which is allocated once, the
+ * producer and the consumer only share two counters.
+ * <br />the consumer may block in pop(). it is woken up by the next push()
+ * or by close(), the producer only locks a mutex when the consumer sleeps.
+ */
+template<typename T>
+class LockFreeQueue {
+private:
+    std::vector<T> items;
+    /// the number of items pushed (written by the producer only)
+    volatile unsigned long tail;
+    /// the number of items popped (written by the consumer only)
+    volatile unsigned long head;
+    volatile bool closed;
+
+    /// true while the consumer sleeps in pop()
+    volatile bool consumerWaiting;
+    Mutex mutex;
+    Condition notEmpty;
+
+    LockFreeQueue(const LockFreeQueue&);
+    LockFreeQueue& operator=(const LockFreeQueue&);
+
+    void wakeConsumer() {
+        // the consumer sets consumerWaiting before it checks the queue a
+        // last time, the producer publishes the item before it checks the
+        // flag. one of them sees the other
+        __sync_synchronize();
+        if (consumerWaiting) {
+            ScopedLock lock(mutex);
+            notEmpty.signal();
+        }
+    }
+
+public:
+
+    /**
+     * @param capacity the maximum number of queued items (at least 1)
+     */
+    LockFreeQueue(unsigned int capacity) : items(capacity > 0 ? capacity : 1),
+    tail(0), head(0), closed(false), consumerWaiting(false) {
+    }
+
+    /**
+     * appends an item if there is space. must only be called by the producer
+     * @param item the item to append (it is copied into the ring buffer)
+     * @return false if the queue is full or closed, the item was not appended
+     */
+    bool tryPush(const T& item) {
+        if (closed || tail - head == items.size())
+            return false;
+
+        items[tail % items.size()] = item;
+        // the item must be visible before the consumer sees the new tail
+        __sync_synchronize();
+        tail = tail + 1;
+
+        wakeConsumer();
+        return true;
+    }
+
+    /**
+     * removes the oldest item if there is one. must only be called by the
+     * consumer
+     * @param item the removed item
+     * @return false if the queue is empty
+     */
+    bool tryPop(T& item) {
+        if (head == tail)
+            return false;
+
+        // read the item after the tail
+        __sync_synchronize();
+        unsigned int index = head % items.size();
+        item = items[index];
+        // do not keep references (e.g. to image data) in the ring
+        items[index] = T();
+
+        // the slot must be free before the producer sees the new head
+        __sync_synchronize();
+        head = head + 1;
+        return true;
+    }
+
+    /**
+     * removes the oldest item, blocks while the queue is empty. must only be
+     * called by the consumer
+     * @param item the removed item
+     * @return false if the queue has been closed and all items were removed
+     */
+    bool pop(T& item) {
+        while (!tryPop(item)) {
+            ScopedLock lock(mutex);
+            consumerWaiting = true;
+            __sync_synchronize();
+
+            // an item may have been pushed before the flag was set
+            if (head == tail && !closed)
+                notEmpty.wait(mutex);
+            consumerWaiting = false;
+
+            if (head == tail && closed)
+                return false;
+        }
+        return true;
+    }
+
+    /**
+     * closes the queue. tryPush() fails from now on, the consumer still gets
+     * the queued items
+     */
+    void close() {
+        ScopedLock lock(mutex);
+        closed = true;
+        notEmpty.broadcast();
+    }
+
+    /**
+     * must only be called by the producer. the space stays free until the
+     * producer pushes, the consumer can only free more
+     * @return true if the next tryPush() will append its item
+     */
+    bool hasSpace() const {
+        return !closed && tail - head < items.size();
+    }
+
+    bool isClosed() const {
+        return closed;
+    }
+
+    /**
+     * @return the number of queued items (a snapshot, it may be outdated as
+     *  soon as it is returned)
+     */
+    unsigned int size() const {
+        return tail - head;
+    }
+};
+
+#endif /* LOCKFREEQUEUE_HPP_ */
@@ -0,0 +1,99 @@
+#ifndef SPSCQUEUE_HPP_
+#define SPSCQUEUE_HPP_
+
+#include <vector>
+
+#include "threads.hpp"
+
+/**
+ * a bounded first-in first-out queue connecting exactly one producer thread
+ * with one consumer thread. the items are kept in a ring buffer which is
+ * allocated once, push() blocks while the queue is full and pop() blocks
+ * while it is empty.
+ * <br />either side can close() the queue: the producer to signal the end
+ * of the stream (the consumer still gets the queued items), the consumer to
+ * tell the producer that nobody is interested in more items.
+ */
+template<typename T>
+class SpscQueue {
+private:
+    std::vector<T> items;
+    /// the index of the oldest item
+    unsigned int head;
+    /// the number of queued items
+    unsigned int size;
+    bool closed;
+
+    Mutex mutex;
+    Condition notEmpty;
+    Condition notFull;
+
+    SpscQueue(const SpscQueue&);
+    SpscQueue& operator=(const SpscQueue&);
+public:
+
+    /**
+     * @param capacity the maximum number of queued items (at least 1)
+     */
+    SpscQueue(unsigned int capacity) : items(capacity > 0 ? capacity : 1),
+    head(0), size(0), closed(false) {
+    }
+
+    /**
+     * appends an item, blocks while the queue is full
+     * @param item the item to append (it is copied into the ring buffer)
+     * @return false if the queue has been closed, the item was not appended
+     */
+    bool push(const T& item) {
+        ScopedLock lock(mutex);
+        while (!closed && size == items.size())
+            notFull.wait(mutex);
+
+        if (closed)
+            return false;
+
+        items[(head + size) % items.size()] = item;
+        ++size;
+        notEmpty.signal();
+        return true;
+    }
+
+    /**
+     * removes the oldest item, blocks while the queue is empty
+     * @param item the removed item
+     * @return false if the queue has been closed and all items were removed
+     */
+    bool pop(T& item) {
+        ScopedLock lock(mutex);
+        while (!closed && size == 0)
+            notEmpty.wait(mutex);
+
+        if (size == 0)
+            return false;
+
+        item = items[head];
+        // do not keep references (e.g. to image data) in the ring
+        items[head] = T();
+        head = (head + 1) % items.size();
+        --size;
+        notFull.signal();
+        return true;
+    }
+
+    /**
+     * closes the queue and wakes up both sides
+     */
+    void close() {
+        ScopedLock lock(mutex);
+        closed = true;
+        notEmpty.broadcast();
+        notFull.broadcast();
+    }
+
+    bool isClosed() {
+        ScopedLock lock(mutex);
+        return closed;
+    }
+};
+
+#endif /* SPSCQUEUE_HPP_ */
@@ -0,0 +1,197 @@
+#include <iomanip>
+
+#include "latency.hpp"
+
+using namespace std;
+using namespace cv;
+
+const int LatencyHistogram::SUB_BUCKET_BITS;
+const int LatencyHistogram::SUB_BUCKETS;
+const int LatencyHistogram::MAX_MAGNITUDE;
+const int LatencyHistogram::NUM_OF_BUCKETS;
+
+static LatencyHistogram histograms[NUM_OF_STAGES];
+static volatile bool timingEnabled = true;
+static const double MICROS_PER_TICK = 1e6 / getTickFrequency();
+/// the FrameTimings of the innermost FrameTimingScope of each thread
+static __thread FrameTimings *frameTimings = NULL;
+
+static const char* STAGE_NAMES[NUM_OF_STAGES] = {
+    "grab frame",
+    "crop",
+    "find eye region",
+    "find glints",
+    "remove glints",
+    "median blur",
+    "starburst",
+    "ransac",
+    "fit circle",
+    "callback",
+};
+
+LatencyHistogram::LatencyHistogram() {
+    reset();
+}
+
+int LatencyHistogram::bucketOf(uint64 micros) {
+    const uint64 largest = ((uint64) 2 << MAX_MAGNITUDE) - 1;
+    if (micros > largest)
+        micros = largest;
+
+    // the small values have a bucket each
+    if (micros < (uint64) SUB_BUCKETS)
+        return micros;
+
+    int magnitude = 63 - __builtin_clzll(micros);
+    int shift = magnitude - SUB_BUCKET_BITS;
+    // between SUB_BUCKETS and 2 * SUB_BUCKETS - 1
+    int mantissa = micros >> shift;
+
+    return SUB_BUCKETS * shift + mantissa;
+}
+
+uint64 LatencyHistogram::lowerBoundOf(int bucket) {
+    if (bucket < SUB_BUCKETS)
+        return bucket;
+
+    int shift = bucket / SUB_BUCKETS - 1;
+    uint64 mantissa = bucket % SUB_BUCKETS + SUB_BUCKETS;
+    return mantissa << shift;
+}
+
+uint64 LatencyHistogram::upperBoundOf(int bucket) {
+    if (bucket < SUB_BUCKETS)
+        return bucket;
+
+    int shift = bucket / SUB_BUCKETS - 1;
+    uint64 mantissa = bucket % SUB_BUCKETS + SUB_BUCKETS;
+    return ((mantissa + 1) << shift) - 1;
+}
+
+void LatencyHistogram::record(uint64 micros) {
+    __sync_fetch_and_add(&counts[bucketOf(micros)], 1);
+    __sync_fetch_and_add(&numOfValues, 1);
+    __sync_fetch_and_add(&sum, micros);
+
+    uint64 current = maximum;
+    while (micros > current && !__sync_bool_compare_and_swap(&maximum, current, micros))
+        current = maximum;
+}
+
+uint64 LatencyHistogram::count() const {
+    return numOfValues;
+}
+
+double LatencyHistogram::mean() const {
+    uint64 values = numOfValues;
+    return values > 0 ? (double) sum / values : 0;
+}
+
+uint64 LatencyHistogram::max() const {
+    return maximum;
+}
+
+uint64 LatencyHistogram::percentile(double percent) const {
+    // the buckets may have been incremented after numOfValues was read
+    uint64 total = 0;
+    for (int i = 0; i < NUM_OF_BUCKETS; ++i)
+        total += counts[i];
+
+    if (total == 0)
+        return 0;
+
+    uint64 rank = (uint64) (percent / 100 * total + 0.5);
+    if (rank < 1)
+        rank = 1;
+
+    uint64 seen = 0;
+    for (int i = 0; i < NUM_OF_BUCKETS; ++i) {
+        seen += counts[i];
+        if (seen >= rank) {
+            uint64 value = upperBoundOf(i);
+            return value < maximum ? value : maximum;
+        }
+    }
+
+    return maximum;
+}
+
+void LatencyHistogram::reset() {
+    for (int i = 0; i < NUM_OF_BUCKETS; ++i)
+        counts[i] = 0;
+    numOfValues = 0;
+    sum = 0;
+    maximum = 0;
+}
+
+LatencyHistogram& StageTimings::histogram(TrackerStage stage) {
+    return histograms[stage];
+}
+
+const char* StageTimings::name(TrackerStage stage) {
+    return STAGE_NAMES[stage];
+}
+
+void StageTimings::print(ostream& out) {
+    out << left << setw(18) << "stage" << right
+            << setw(10) << "count"
+            << setw(10) << "mean"
+            << setw(10) << "p50"
+            << setw(10) << "p90"
+            << setw(10) << "p99"
+            << setw(10) << "max" << "  (microseconds)" << endl;
+
+    for (int i = 0; i < NUM_OF_STAGES; ++i) {
+        const LatencyHistogram& h = histograms[i];
+        if (h.count() == 0)
+            continue;
+
+        out << left << setw(18) << STAGE_NAMES[i] << right
+                << setw(10) << h.count()
+                << setw(10) << (uint64) h.mean()
+                << setw(10) << h.percentile(50)
+                << setw(10) << h.percentile(90)
+                << setw(10) << h.percentile(99)
+                << setw(10) << h.max() << endl;
+    }
+}
+
+void StageTimings::reset() {
+    for (int i = 0; i < NUM_OF_STAGES; ++i)
+        histograms[i].reset();
+}
+
+void StageTimings::setEnabled(bool enabled) {
+    timingEnabled = enabled;
+}
+
+bool StageTimings::isEnabled() {
+    return timingEnabled;
+}
+
+ScopedTimer::ScopedTimer(TrackerStage stage) : stage(stage), startTick(0) {
+    if (timingEnabled)
+        startTick = getTickCount();
+}
+
+FrameTimingScope::FrameTimingScope(FrameTimings& timings) : previous(frameTimings) {
+    frameTimings = &timings;
+}
+
+FrameTimingScope::~FrameTimingScope() {
+    frameTimings = previous;
+}
+
+void ScopedTimer::stop() {
+    if (startTick != 0) {
+        uint64 micros = (getTickCount() - startTick) * MICROS_PER_TICK;
+        histograms[stage].record(micros);
+        if (frameTimings != NULL)
+            frameTimings->micros[stage] += micros;
+    }
+    startTick = 0;
+}
+
+ScopedTimer::~ScopedTimer() {
+    stop();
+}
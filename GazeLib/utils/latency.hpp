@@ -0,0 +1,232 @@
+#ifndef LATENCY_HPP_
+#define LATENCY_HPP_
+
+#include <ostream>
+
+#include <opencv2/core/core.hpp>
+
+/**
+ * the stages of the processing of a frame which are timed
+ */
+enum TrackerStage {
+    /// ImageSource::nextGrayFrame()
+    STAGE_GRAB_FRAME,
+    /// cropping the eye region
+    STAGE_CROP,
+    /// the haar classifiers searching the eye region (including the
+    /// FindGlints validating the eyes)
+    STAGE_FIND_EYE_REGION,
+    /// FindGlints::findGlints()
+    STAGE_FIND_GLINTS,
+    /// removing the glints before the starburst algorithm
+    STAGE_REMOVE_GLINTS,
+    /// the median blur before the starburst algorithm
+    STAGE_MEDIAN_BLUR,
+    /// the iterations of the starburst algorithm (without RANSAC)
+    STAGE_STARBURST,
+    /// Ransac::ransac() (including the final bestFitCircle())
+    STAGE_RANSAC,
+    /// bestFitCircle() of the RANSAC inliers
+    STAGE_FIT_CIRCLE,
+    /// the TrackerCallback
+    STAGE_CALLBACK,
+    NUM_OF_STAGES,
+};
+
+/**
+ * a histogram of durations in microseconds. the values are grouped by their
+ * power of two, each group is split into 16 linear buckets. this way every
+ * value between 1 microsecond and hours is kept with a relative error of
+ * about 6% in a few kilobytes.
+ * <br />record() only uses atomic increments, so any number of threads can
+ * record into the same histogram without locks. the queries read the
+ * counters without a lock and may miss samples recorded at the same time.
+ */
+class LatencyHistogram {
+public:
+    /// the number of linear buckets per power of two is 2^SUB_BUCKET_BITS
+    static const int SUB_BUCKET_BITS = 4;
+    static const int SUB_BUCKETS = 1 << SUB_BUCKET_BITS;
+    /// values of 2^(MAX_MAGNITUDE + 1) microseconds and more end up in the
+    /// last bucket
+    static const int MAX_MAGNITUDE = 36;
+    static const int NUM_OF_BUCKETS = SUB_BUCKETS * (MAX_MAGNITUDE - SUB_BUCKET_BITS + 2);
+
+    LatencyHistogram();
+
+    /**
+     * @param micros a duration in microseconds
+     */
+    void record(uint64 micros);
+
+    /**
+     * @return the number of recorded durations
+     */
+    uint64 count() const;
+
+    /**
+     * @return the mean of the recorded durations in microseconds
+     */
+    double mean() const;
+
+    /**
+     * @return the longest recorded duration in microseconds
+     */
+    uint64 max() const;
+
+    /**
+     * @param percent 0 to 100
+     * @return the duration (in microseconds) which percent of the recorded
+     *  durations do not exceed
+     */
+    uint64 percentile(double percent) const;
+
+    /**
+     * forgets all recorded durations
+     */
+    void reset();
+
+private:
+    volatile uint64 counts[NUM_OF_BUCKETS];
+    volatile uint64 numOfValues;
+    volatile uint64 sum;
+    volatile uint64 maximum;
+
+    static int bucketOf(uint64 micros);
+    static uint64 lowerBoundOf(int bucket);
+    static uint64 upperBoundOf(int bucket);
+
+    LatencyHistogram(const LatencyHistogram&);
+    LatencyHistogram& operator=(const LatencyHistogram&);
+};
+
+/**
+ * the process wide latency histograms of the TrackerStages. all GazeTrackers
+ * (and all threads) record into the same histograms.
+ *
+ * usage:
+ * <pre>
+ * cout << StageTimings::histogram(STAGE_FIND_GLINTS).percentile(99) << endl;
+ * StageTimings::print(cout);
+ * </pre>
+ */
+class StageTimings {
+public:
+    /**
+     * @return the histogram of the stage
+     */
+    static LatencyHistogram& histogram(TrackerStage stage);
+
+    /**
+     * @return the name of the stage
+     */
+    static const char* name(TrackerStage stage);
+
+    /**
+     * prints count, mean, percentiles and maximum of every stage
+     */
+    static void print(std::ostream& out);
+
+    /**
+     * forgets all recorded durations
+     */
+    static void reset();
+
+    /**
+     * switches the timing on or off (default: on). while it is off a
+     * ScopedTimer costs a single comparison
+     */
+    static void setEnabled(bool enabled);
+
+    static bool isEnabled();
+};
+
+/**
+ * the durations of the TrackerStages while processing a single frame, in
+ * microseconds. a stage which runs more than once per frame (e.g. in the
+ * binocular tracking) is summed up.
+ * @see FrameTimingScope
+ */
+struct FrameTimings {
+    uint64 micros[NUM_OF_STAGES];
+
+    FrameTimings() {
+        reset();
+    }
+
+    void reset() {
+        for (int i = 0; i < NUM_OF_STAGES; ++i)
+            micros[i] = 0;
+    }
+
+    /**
+     * adds the durations of the stages of another frame (or another thread)
+     */
+    FrameTimings& operator+=(const FrameTimings& other) {
+        for (int i = 0; i < NUM_OF_STAGES; ++i)
+            micros[i] += other.micros[i];
+        return *this;
+    }
+};
+
+/**
+ * while a FrameTimingScope lives, every ScopedTimer of the same thread adds
+ * its duration to the given FrameTimings too. this way the durations of a 
+ * single frame are collected without passing the FrameTimings through all
+ * algorithms. scopes may be nested, the previous FrameTimings are restored
+ * at the destruction.
+ * <br />nothing is collected while StageTimings are switched off
+ *
+ * usage:
+ * <pre>
+ * FrameTimings timings;
+ * {
+ *     FrameTimingScope scope(timings);
+ *     glintFinder.findGlints(...);
+ * }
+ * cout << timings.micros[STAGE_FIND_GLINTS] << endl;
+ * </pre>
+ */
+class FrameTimingScope {
+private:
+    FrameTimings *previous;
+
+    FrameTimingScope(const FrameTimingScope&);
+    FrameTimingScope& operator=(const FrameTimingScope&);
+public:
+    FrameTimingScope(FrameTimings& timings);
+    ~FrameTimingScope();
+};
+
+/**
+ * measures the time from its construction to its destruction and records
+ * it in the histogram of a TrackerStage (and the FrameTimings of the current
+ * FrameTimingScope)
+ *
+ * usage:
+ * <pre>
+ * {
+ *     ScopedTimer timer(STAGE_FIND_GLINTS);
+ *     ...
+ * }
+ * </pre>
+ */
+class ScopedTimer {
+private:
+    TrackerStage stage;
+    int64 startTick;
+
+    ScopedTimer(const ScopedTimer&);
+    ScopedTimer& operator=(const ScopedTimer&);
+public:
+    ScopedTimer(TrackerStage stage);
+
+    /**
+     * records the time now instead of at the destruction
+     */
+    void stop();
+
+    ~ScopedTimer();
+};
+
+#endif /* LATENCY_HPP_ */
@@ -0,0 +1,96 @@
+#include "threads.hpp"
+#include "../exception/GazeExceptions.hpp"
+
+//
+// Mutex
+//
+
+Mutex::Mutex() {
+    pthread_mutex_init(&mutex, NULL);
+}
+
+Mutex::~Mutex() {
+    pthread_mutex_destroy(&mutex);
+}
+
+void Mutex::lock() {
+    pthread_mutex_lock(&mutex);
+}
+
+void Mutex::unlock() {
+    pthread_mutex_unlock(&mutex);
+}
+
+//
+// ScopedLock
+//
+
+ScopedLock::ScopedLock(Mutex& mutex) : mutex(mutex) {
+    mutex.lock();
+}
+
+ScopedLock::~ScopedLock() {
+    mutex.unlock();
+}
+
+//
+// Condition
+//
+
+Condition::Condition() {
+    pthread_cond_init(&condition, NULL);
+}
+
+Condition::~Condition() {
+    pthread_cond_destroy(&condition);
+}
+
+void Condition::wait(Mutex& mutex) {
+    pthread_cond_wait(&condition, &mutex.mutex);
+}
+
+void Condition::signal() {
+    pthread_cond_signal(&condition);
+}
+
+void Condition::broadcast() {
+    pthread_cond_broadcast(&condition);
+}
+
+//
+// Thread
+//
+
+Thread::Thread() : started(false) {
+}
+
+Thread::~Thread() {
+    // the subclass must have joined the thread already, run() is gone by now
+}
+
+void* Thread::entry(void* self) {
+    static_cast<Thread*> (self)->run();
+    return NULL;
+}
+
+void Thread::start() {
+    if (started)
+        return;
+
+    if (pthread_create(&thread, NULL, &Thread::entry, this) != 0)
+        throw GazeException("Could not create a new thread");
+
+    started = true;
+}
+
+void Thread::join() {
+    if (!started)
+        return;
+
+    pthread_join(thread, NULL);
+    started = false;
+}
+
+bool Thread::isStarted() const {
+    return started;
+}
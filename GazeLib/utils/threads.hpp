@@ -0,0 +1,103 @@
+#ifndef THREADS_HPP_
+#define THREADS_HPP_
+
+#include <pthread.h>
+
+/**
+ * thin wrapper around a pthread mutex. the GazeLib does not depend on Qt,
+ * so this is what the library uses wherever data is shared between threads.
+ */
+class Mutex {
+    friend class Condition;
+private:
+    pthread_mutex_t mutex;
+
+    // not copyable
+    Mutex(const Mutex&);
+    Mutex& operator=(const Mutex&);
+public:
+    Mutex();
+    ~Mutex();
+    void lock();
+    void unlock();
+};
+
+/**
+ * locks the given Mutex for the lifetime of this object
+ */
+class ScopedLock {
+private:
+    Mutex& mutex;
+
+    ScopedLock(const ScopedLock&);
+    ScopedLock& operator=(const ScopedLock&);
+public:
+    ScopedLock(Mutex& mutex);
+    ~ScopedLock();
+};
+
+/**
+ * wrapper around a pthread condition variable
+ */
+class Condition {
+private:
+    pthread_cond_t condition;
+
+    Condition(const Condition&);
+    Condition& operator=(const Condition&);
+public:
+    Condition();
+    ~Condition();
+
+    /**
+     * waits until the condition is signaled. the mutex MUST be locked by
+     * the callee
+     * @param mutex the (locked) mutex which protects the shared data
+     */
+    void wait(Mutex& mutex);
+    void signal();
+    void broadcast();
+};
+
+/**
+ * base class for a worker thread. subclasses implement run() and call
+ * start() as soon as they are fully constructed. the thread has to be joined
+ * before the subclass is destroyed.
+ */
+class Thread {
+private:
+    pthread_t thread;
+    bool started;
+
+    static void* entry(void* self);
+
+    Thread(const Thread&);
+    Thread& operator=(const Thread&);
+protected:
+    /**
+     * the code that runs in the new thread
+     */
+    virtual void run() = 0;
+public:
+    Thread();
+    virtual ~Thread();
+
+    /**
+     * starts the thread.
+     * @throws GazeException if the thread could not be created
+     */
+    void start();
+
+    /**
+     * blocks until run() has returned. calling join() on a thread that has
+     * not been started is a no-op
+     */
+    void join();
+
+    /**
+     * @return true if start() has been called and the thread was not joined yet
+     */
+    bool isStarted() const;
+};
+
+#endif /* THREADS_HPP_ */
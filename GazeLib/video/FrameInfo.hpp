@@ -0,0 +1,44 @@
+#ifndef FRAMEINFO_HPP_
+#define FRAMEINFO_HPP_
+
+#include "opencv2/core/core.hpp"
+
+/**
+ * The FrameInfo describes a frame delivered by an ImageSource. it is passed
+ * along with the frame through the whole GazeLib pipeline, so clients can
+ * measure how old a measurement is.
+ * <br />all timestamps are in ticks of the monotonic clock of cv::getTickCount()
+ */
+struct FrameInfo {
+    /// the time when the frame was captured (0 if unknown)
+    int64 captureTick;
+    /// the time when the GazeTracker has measured the frame (0 if not measured)
+    int64 measureTick;
+    /// the sequence number of the frame. the first frame has the number 1
+    unsigned long sequenceNumber;
+    /// the resolution of the full frame (the camera or video resolution)
+    cv::Size resolution;
+    /// the part of the full frame the delivered frame contains. this is the
+    /// whole frame unless the ImageSource honoured a region of interest
+    cv::Rect region;
+
+    FrameInfo() : captureTick(0), measureTick(0), sequenceNumber(0) {
+    }
+
+    /**
+     * @return the time in milliseconds between capturing the frame and now
+     */
+    double millisSinceCapture() const {
+        return (cv::getTickCount() - captureTick) * 1000. / cv::getTickFrequency();
+    }
+
+    /**
+     * @return the time in milliseconds between capturing the frame and
+     *  measuring the GazeVector
+     */
+    double measureLatencyMillis() const {
+        return (measureTick - captureTick) * 1000. / cv::getTickFrequency();
+    }
+};
+
+#endif /* FRAMEINFO_HPP_ */
@@ -0,0 +1,118 @@
+#include "opencv2/imgproc/imgproc.hpp"
+#include "opencv2/highgui/highgui.hpp"
+
+#include "ImageSource.hpp"
+#include "../exception/GazeExceptions.hpp"
+
+using namespace cv;
+
+bool ImageSource::isShared(const Mat& image) {
+    return image.refcount != NULL && *image.refcount > 1;
+}
+
+Mat& ImageSource::grayBufferFor(Mat& frame) {
+    // a frame which has been cropped by the client cannot be reused, 
+    // nor can a frame that is still referenced elsewhere (e.g. in the GUI)
+    if (!frame.isSubmatrix() && !isShared(frame))
+        return frame;
+
+    frame.release();
+    if (isShared(grayBuffer))
+        grayBuffer.release();
+
+    return grayBuffer;
+}
+
+Rect ImageSource::regionIn(const Size& resolution) const {
+    Rect fullFrame(Point(), resolution);
+    Rect region = regionOfInterest & fullFrame;
+
+    if (region.width <= 0 || region.height <= 0)
+        return fullFrame;
+
+    return region;
+}
+
+/**
+ * where the luma of a native frame lies
+ */
+enum LumaLayout {
+    LUMA_UNKNOWN,
+    /// a single gray channel
+    LUMA_GRAY,
+    /// the luma plane followed by the chroma planes (one channel)
+    LUMA_PLANAR,
+    /// packed Y U Y V (two channels, the luma is the first)
+    LUMA_FIRST_CHANNEL,
+    /// packed U Y V Y (two channels, the luma is the second)
+    LUMA_SECOND_CHANNEL
+};
+
+static LumaLayout lumaLayout(int fourcc) {
+    switch (fourcc) {
+        case CV_FOURCC('G', 'R', 'E', 'Y'):
+        case CV_FOURCC('Y', '8', '0', '0'):
+        case CV_FOURCC('Y', '8', ' ', ' '):
+            return LUMA_GRAY;
+        case CV_FOURCC('N', 'V', '1', '2'):
+        case CV_FOURCC('N', 'V', '2', '1'):
+        case CV_FOURCC('I', '4', '2', '0'):
+        case CV_FOURCC('I', 'Y', 'U', 'V'):
+        case CV_FOURCC('Y', 'V', '1', '2'):
+            return LUMA_PLANAR;
+        case CV_FOURCC('Y', 'U', 'Y', 'V'):
+        case CV_FOURCC('Y', 'U', 'Y', '2'):
+        case CV_FOURCC('Y', 'U', 'N', 'V'):
+        case CV_FOURCC('Y', 'V', 'Y', 'U'):
+        case CV_FOURCC('V', '4', '2', '2'):
+            return LUMA_FIRST_CHANNEL;
+        case CV_FOURCC('U', 'Y', 'V', 'Y'):
+        case CV_FOURCC('Y', '4', '2', '2'):
+        case CV_FOURCC('U', 'Y', 'N', 'V'):
+        case CV_FOURCC('H', 'D', 'Y', 'C'):
+            return LUMA_SECOND_CHANNEL;
+    }
+    return LUMA_UNKNOWN;
+}
+
+bool ImageSource::hasLumaLayout(int fourcc) {
+    return lumaLayout(fourcc) != LUMA_UNKNOWN;
+}
+
+Mat ImageSource::imagePlane(const Mat& raw, int fourcc) {
+    if (lumaLayout(fourcc) == LUMA_PLANAR)
+        return raw.rowRange(0, raw.rows * 2 / 3);
+    return raw;
+}
+
+void ImageSource::toGray(const Mat& raw, Mat& gray, int fourcc) {
+    if (fourcc != 0) {
+        LumaLayout layout = lumaLayout(fourcc);
+        int channels = (layout == LUMA_GRAY || layout == LUMA_PLANAR) ? 1 : 2;
+        if (layout == LUMA_UNKNOWN || raw.channels() != channels)
+            throw WrongArgumentException("Unsupported frame format");
+
+        if (channels == 1) {
+            raw.copyTo(gray);
+        } else {
+            const int lumaChannel[] = {layout == LUMA_SECOND_CHANNEL ? 1 : 0, 0};
+            gray.create(raw.size(), CV_8UC1);
+            mixChannels(&raw, 1, &gray, 1, lumaChannel, 1);
+        }
+        return;
+    }
+
+    switch (raw.channels()) {
+        case 1:
+            raw.copyTo(gray);
+            break;
+        case 3:
+            cvtColor(raw, gray, CV_BGR2GRAY);
+            break;
+        case 4:
+            cvtColor(raw, gray, CV_BGRA2GRAY);
+            break;
+        default:
+            throw WrongArgumentException("Unsupported number of channels");
+    }
+}
@@ -3,25 +3,175 @@
 
 #include "opencv2/core/core.hpp"
 
+#include "FrameInfo.hpp"
+
+/**
+ * controls which frames an ImageSource hands out if the client is slower
+ * than the camera or video
+ */
+enum DeliveryPolicy {
+    /// every frame is delivered, even if it is already stale
+    DELIVER_EVERY_FRAME,
+    /// only the newest frame is delivered, older frames are dropped
+    DELIVER_LATEST_FRAME,
+};
 
 /**
  * ImageSource is the API for accessing video data from an video or camera device.
  * <br />in client applications you should use the implementations LiveSource and VideoSource
+ * <br />each frame is described by a FrameInfo. its sequence number counts
+ * every frame the source has captured, so a gap between two delivered frames
+ * is the number of dropped frames.
  * @see LiveSource
  * @see VideoSource
  */
 class ImageSource {
 
+protected:
+    DeliveryPolicy deliveryPolicy;
+    /// implementations increment this for every frame they capture (or skip)
+    unsigned long sequenceNumber;
+    /// the description of the frame returned by the last nextGrayFrame()
+    FrameInfo frameInfo;
+
+    /**
+     * implementations call this for every frame they deliver
+     * @param captureTick the time when the frame was captured
+     * @param frame the delivered frame
+     */
+    void frameCaptured(int64 captureTick, const cv::Mat& frame) {
+        frameCaptured(captureTick, frame.size(), cv::Rect(cv::Point(), frame.size()));
+    }
+
+    /**
+     * implementations which deliver only the region of interest call this
+     * for every frame they deliver
+     * @param captureTick the time when the frame was captured
+     * @param resolution the size of the full frame
+     * @param region the part of the full frame which has been delivered
+     */
+    void frameCaptured(int64 captureTick, const cv::Size& resolution, const cv::Rect& region) {
+        frameInfo.captureTick = captureTick;
+        frameInfo.measureTick = 0;
+        frameInfo.sequenceNumber = sequenceNumber;
+        frameInfo.resolution = resolution;
+        frameInfo.region = region;
+    }
+
+    /**
+     * @param resolution the size of the full frame
+     * @return the region of interest clipped to the full frame, or the full
+     *  frame if there is no region of interest (or it lies outside the frame)
+     */
+    cv::Rect regionIn(const cv::Size& resolution) const;
+
+    /**
+     * returns the buffer an implementation should write the next gray frame
+     * into. this is the clients frame if nobody else uses its pixels,
+     * otherwise an internal buffer that is reused as long as the client 
+     * releases its frames. if the returned buffer is not the clients frame,
+     * the implementation must assign it to the frame afterwards.
+     * @param frame the frame passed to nextGrayFrame()
+     * @return the buffer to write the gray frame into
+     */
+    cv::Mat& grayBufferFor(cv::Mat& frame);
+
+    /**
+     * @param fourcc the format of a native camera frame (CV_CAP_PROP_FOURCC)
+     * @return true if toGray() knows where the luma of this format lies
+     */
+    static bool hasLumaLayout(int fourcc);
+
+    /**
+     * returns the part of a native frame which holds the image. planar YUV
+     * frames (NV12, NV21, I420, YV12) are delivered as a single channel 1.5
+     * times as high as the image, the chroma planes follow the luma plane.
+     * @param raw the captured frame
+     * @param fourcc the format of the frame, 0 for a decoded frame
+     * @return the luma plane of planar frames, the frame itself otherwise (no copy)
+     */
+    static cv::Mat imagePlane(const cv::Mat& raw, int fourcc);
+
+    /**
+     * converts a frame as delivered by the camera or video decoder into a
+     * grayscale image without reallocating gray (if it has the right size). 
+     * the layout of native frames is taken from their format: grayscale and
+     * planar YUV frames are copied, of packed YUV frames (YUYV, UYVY) only
+     * the luma channel is copied. decoded color frames are converted from 
+     * BGR(A).
+     * @param raw the captured frame, the imagePlane() of a native frame
+     * @param gray the grayscale image
+     * @param fourcc the format of a native frame (CV_CAP_PROP_FOURCC), 0 for
+     *  a decoded frame
+     * @throws WrongArgumentException if the format or the number of channels
+     *  is not supported
+     */
+    static void toGray(const cv::Mat& raw, cv::Mat& gray, int fourcc = 0);
+
+    /**
+     * @return true if somebody else than the given Mat holds a reference to
+     *  its pixels
+     */
+    static bool isShared(const cv::Mat& image);
+
+    /// the window the client is interested in (empty for the full frame)
+    cv::Rect regionOfInterest;
+
+private:
+    cv::Mat grayBuffer;
+
 public:
+    ImageSource() : deliveryPolicy(DELIVER_EVERY_FRAME), sequenceNumber(0) {}
 	virtual ~ImageSource() {}
     /**
-     * grabs the next frame in the ImageSource and converts it into 
+     * grabs the next frame in the ImageSource and converts it into
      * a grascale image
-     * 
+     *
      * @param frame the next frame in this ImageSource
-     * @return 
+     * @return
      */
 	virtual bool nextGrayFrame(cv::Mat& frame) = 0;
+
+    /**
+     * @see DeliveryPolicy
+     * @param policy whether stale frames should be dropped or not
+     */
+    virtual void setDeliveryPolicy(DeliveryPolicy policy) {
+        deliveryPolicy = policy;
+    }
+
+    DeliveryPolicy getDeliveryPolicy() const {
+        return deliveryPolicy;
+    }
+
+    /**
+     * tells the source which part of the frame the client is going to
+     * process. sources may then convert and copy only this window (or let
+     * the camera read out only this window) instead of the full frame.
+     * <br />this is only a hint: a source may still deliver the full frame
+     * and a frame captured before may still have the old region. clients
+     * must use FrameInfo::region to find out which part they got.
+     * @param roi the window in full frame coordinates. an empty Rect 
+     *  requests the full frame again
+     */
+    virtual void setRegionOfInterest(const cv::Rect& roi) {
+        regionOfInterest = roi;
+    }
+
+    /**
+     * @return the current region of interest (empty for the full frame)
+     */
+    cv::Rect getRegionOfInterest() const {
+        return regionOfInterest;
+    }
+
+    /**
+     * @return the description (capture time, sequence number, resolution,
+     *  region) of the frame returned by the last call of nextGrayFrame()
+     */
+    const FrameInfo& lastFrameInfo() const {
+        return frameInfo;
+    }
 };
 
 #endif /* IVIDEOSOURCE_HPP_ */
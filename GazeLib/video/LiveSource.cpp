@@ -2,6 +2,8 @@
 
 #include <iostream>
 
+#include "../utils/log.hpp"
+
 using namespace std;
 using namespace cv;
 
@@ -24,6 +26,19 @@ void LiveSource::init(){
     // Set resolution for Microsoft Life cam
     videoCapture->set(CV_CAP_PROP_FRAME_WIDTH, 1280);
     videoCapture->set(CV_CAP_PROP_FRAME_HEIGHT, 720);
+
+    // ask for the native (usually YUV) frames, which contain the luma plane.
+    // not every backend supports this.
+    nativeFormat = videoCapture->set(CV_CAP_PROP_CONVERT_RGB, 0);
+    fourcc = nativeFormat ? (int) videoCapture->get(CV_CAP_PROP_FOURCC) : 0;
+
+    // the luma of an unknown format is not guessed, OpenCV decodes it
+    if (nativeFormat && !hasLumaLayout(fourcc)) {
+        LOG_W("LiveSource: unknown frame format " << fourcc << ", decoding to BGR");
+        videoCapture->set(CV_CAP_PROP_CONVERT_RGB, 1);
+        nativeFormat = false;
+        fourcc = 0;
+    }
 }
 
 bool LiveSource::nextGrayFrame(cv::Mat& frame) {
@@ -35,15 +50,66 @@ bool LiveSource::nextGrayFrame(cv::Mat& frame) {
         return false;
 
     // Check if there are more frames
-    if (!videoCapture->read(frame))
+    int64 captureTick = 0;
+    if (deliveryPolicy == DELIVER_LATEST_FRAME) {
+        if (!grabLatest(captureTick))
+            return false;
+    } else {
+        if (!videoCapture->grab())
+            return false;
+        captureTick = getTickCount();
+        ++sequenceNumber;
+    }
+
+    if (!videoCapture->retrieve(rawFrame))
         return false;
 
     // Check for invalid input
-    if (!frame.data)
+    if (!rawFrame.data)
         return false;
 
-    // Convert to grayscale
-    cvtColor(frame, frame, CV_BGR2GRAY);
+    // compressed formats (MJPEG) are delivered as one row of bytes.
+    // the next frames are decoded by OpenCV, the frame already grabbed is
+    // decoded here (grabbing another one would drop it)
+    if (nativeFormat && rawFrame.rows == 1) {
+        LOG_W("LiveSource: camera delivers compressed frames, decoding to BGR");
+        videoCapture->set(CV_CAP_PROP_CONVERT_RGB, 1);
+        nativeFormat = false;
+        fourcc = 0;
+
+        rawFrame = imdecode(rawFrame, CV_LOAD_IMAGE_GRAYSCALE);
+        if (!rawFrame.data)
+            return false;
+    }
+
+    // Convert to grayscale, only the region of interest
+    Mat image = imagePlane(rawFrame, fourcc);
+    Rect region = regionIn(image.size());
+    Mat& gray = grayBufferFor(frame);
+    toGray(image(region), gray, fourcc);
+    if (&gray != &frame)
+        frame = gray;
+
+    frameCaptured(captureTick, image.size(), region);
+
+    return true;
+}
+
+bool LiveSource::grabLatest(int64& captureTick) {
+    // grab until the driver has to wait for a fresh frame. all frames
+    // grabbed before were already queued and therefore stale
+    for (int i = 0; i < MAX_QUEUED_FRAMES; ++i) {
+        int64 start = getTickCount();
+
+        if (!videoCapture->grab())
+            return false;
+        captureTick = getTickCount();
+        ++sequenceNumber;
+
+        double millis = (captureTick - start) * 1000. / getTickFrequency();
+        if (millis > QUEUED_FRAME_MAX_MILLIS)
+            break;
+    }
 
     return true;
 }
@@ -9,10 +9,29 @@
 /**
  * the LiveSource class provides access to a hardware device. per default 
  * a LiveSource open the camera at channel 0
+ * <br />the camera driver queues a few frames. with DELIVER_LATEST_FRAME the
+ * queued (stale) frames are skipped and counted as dropped frames.
+ * <br />if the camera delivers YUV or grey frames, the luma plane is taken
+ * directly instead of decoding to BGR and converting back to gray. frames
+ * of a format whose layout is unknown are decoded to BGR by OpenCV.
+ * <br />if a region of interest is set only this window is converted.
  */
 class LiveSource : public ImageSource {
 private:
     cv::VideoCapture *videoCapture;
+    /// the captured frame in the cameras format (reused for every frame)
+    cv::Mat rawFrame;
+    /// true if the camera delivers frames in its native format
+    bool nativeFormat;
+    /// the native format (CV_CAP_PROP_FOURCC), 0 for decoded BGR frames
+    int fourcc;
+
+    /// the maximum number of frames the driver keeps in its queue
+    static const int MAX_QUEUED_FRAMES = 5;
+    /// a grab returning faster than this did not wait for a new frame (ms)
+    static const int QUEUED_FRAME_MAX_MILLIS = 4;
+
+    bool grabLatest(int64& captureTick);
 protected:
     void init();
 public:
@@ -0,0 +1,129 @@
+#include <cstring>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "MmapFrameSource.hpp"
+#include "../exception/GazeExceptions.hpp"
+
+using namespace std;
+using namespace cv;
+
+MmapFrameSource::MmapFrameSource(string path) : mapping(NULL), mappingSize(0),
+header(NULL), index(NULL), position(0), startTick(0) {
+
+    fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+        throw GazeException("Could not open the recording " + path);
+
+    struct stat fileStat;
+    if (fstat(fd, &fileStat) != 0 || (size_t) fileStat.st_size < sizeof (RawFrameHeader)) {
+        unmap();
+        throw GazeException("Not a raw frame file: " + path);
+    }
+
+    // read only: a frame that has been drawn into would be replayed with the
+    // drawing after a seek(). writing into a frame fails instead
+    mappingSize = fileStat.st_size;
+    void *addr = mmap(NULL, mappingSize, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (addr == MAP_FAILED) {
+        mapping = NULL;
+        unmap();
+        throw GazeException("Could not map the recording " + path);
+    }
+    mapping = static_cast<unsigned char*> (addr);
+
+    header = reinterpret_cast<const RawFrameHeader*> (mapping);
+
+    uint64_t frameSize = (uint64_t) header->width * header->height;
+    uint64_t indexSize = (uint64_t) header->frameCount * sizeof (RawFrameIndexEntry);
+    bool valid = strncmp(header->magic, RAW_FRAME_MAGIC, sizeof (header->magic)) == 0
+            && header->version == RAW_FRAME_VERSION
+            && header->indexOffset + indexSize <= mappingSize
+            && sizeof (RawFrameHeader) + frameSize * header->frameCount <= header->indexOffset;
+
+    if (!valid) {
+        unmap();
+        throw GazeException("Not a valid raw frame file: " + path);
+    }
+
+    index = reinterpret_cast<const RawFrameIndexEntry*> (mapping + header->indexOffset);
+
+    // tell the kernel that we read the file from the beginning to the end
+    madvise(mapping, mappingSize, MADV_SEQUENTIAL);
+}
+
+MmapFrameSource::~MmapFrameSource() {
+    unmap();
+}
+
+void MmapFrameSource::unmap() {
+    if (mapping != NULL)
+        munmap(mapping, mappingSize);
+    mapping = NULL;
+
+    if (fd >= 0)
+        close(fd);
+    fd = -1;
+}
+
+bool MmapFrameSource::nextGrayFrame(cv::Mat& frame) {
+
+    if (deliveryPolicy == DELIVER_LATEST_FRAME && position < header->frameCount) {
+        if (startTick == 0)
+            startTick = getTickCount() - recordedMicros(position) * getTickFrequency() / 1000000.;
+
+        // skip the frames which a camera would already have replaced
+        int64 elapsedMicros = (getTickCount() - startTick) * 1000000. / getTickFrequency();
+        while (position + 1 < header->frameCount && recordedMicros(position + 1) <= elapsedMicros)
+            ++position;
+    }
+
+    if (position >= header->frameCount)
+        return false;
+
+    const RawFrameIndexEntry& entry = index[position++];
+    if (entry.offset + (uint64_t) header->width * header->height > header->indexOffset)
+        return false;
+
+    // no copy: the frame points into the read only mapping
+    Mat fullFrame(header->height, header->width, CV_8UC1, mapping + entry.offset);
+    Rect region = regionIn(fullFrame.size());
+    frame = fullFrame(region);
+
+    sequenceNumber = entry.sequenceNumber;
+    frameCaptured(getTickCount(), fullFrame.size(), region);
+
+    return true;
+}
+
+unsigned int MmapFrameSource::frameCount() const {
+    return header->frameCount;
+}
+
+void MmapFrameSource::seek(unsigned int frameIndex) {
+    position = frameIndex;
+    startTick = 0;
+}
+
+bool MmapFrameSource::isRawFrameFile(string path) {
+    int file = open(path.c_str(), O_RDONLY);
+    if (file < 0)
+        return false;
+
+    RawFrameHeader fileHeader;
+    bool isRaw = read(file, &fileHeader, sizeof (fileHeader)) == sizeof (fileHeader)
+            && strncmp(fileHeader.magic, RAW_FRAME_MAGIC, sizeof (fileHeader.magic)) == 0;
+    close(file);
+
+    return isRaw;
+}
+
+int64 MmapFrameSource::recordedMicros(unsigned int frameIndex) const {
+    if (frameIndex >= header->frameCount)
+        throw WrongArgumentException("The recording has no frame at this index");
+
+    return index[frameIndex].captureMicros;
+}
@@ -0,0 +1,88 @@
+#ifndef MMAPFRAMESOURCE_HPP_
+#define MMAPFRAMESOURCE_HPP_
+
+#include <string>
+
+#include "opencv2/core/core.hpp"
+
+#include "ImageSource.hpp"
+#include "RawFrameFormat.hpp"
+
+/**
+ * The MmapFrameSource replays a raw frame file (written by the
+ * RawFrameRecorder). the file is mapped into memory and the frames are handed
+ * out without copying or decoding, so a recorded session can be processed at
+ * memory speed and with exactly the same frames on every run.
+ * <br />the sequence numbers of the recorded session are preserved, so the
+ * frames dropped while recording show up again. with DELIVER_LATEST_FRAME the
+ * session is replayed in real time using the recorded timestamps. the capture
+ * time in the FrameInfo is the time of the replay.
+ * <br />the file is mapped read only, so every replay delivers the recorded
+ * pixels. the frames must not be written: clients that draw into a frame
+ * have to clone it first (writing into the mapping crashes). with a region
+ * of interest the frames are windows of the mapped frames.
+ * <br />the frames point into the mapping, they become invalid once the
+ * source is destroyed. clients that keep a frame longer have to clone it.
+ * @see RawFrameRecorder
+ */
+class MmapFrameSource : public ImageSource {
+private:
+    int fd;
+    unsigned char *mapping;
+    size_t mappingSize;
+
+    const RawFrameHeader *header;
+    const RawFrameIndexEntry *index;
+
+    /// the index of the next frame
+    unsigned int position;
+    /// the tick count when the first frame was delivered
+    int64 startTick;
+
+    void unmap();
+
+    MmapFrameSource(const MmapFrameSource&);
+    MmapFrameSource& operator=(const MmapFrameSource&);
+public:
+    /**
+     * maps the raw frame file at the given path
+     * @param path the recorded session
+     * @throws GazeException if the file cannot be read or is not a raw frame file
+     */
+    MmapFrameSource(std::string path);
+    virtual ~MmapFrameSource();
+
+    /**
+     * points the frame at the next recorded frame, without copying
+     * @param frame the next frame (read only, valid as long as this source)
+     * @return false at the end of the recording
+     */
+    virtual bool nextGrayFrame(cv::Mat& frame);
+
+    /**
+     * @return the number of frames in the recording
+     */
+    unsigned int frameCount() const;
+
+    /**
+     * continues the replay at the given frame
+     * @param frameIndex the index of the next frame (0 is the first frame)
+     */
+    void seek(unsigned int frameIndex);
+
+    /**
+     * @param frameIndex the index of a frame
+     * @return the time in microseconds between the first and the given frame
+     *  when they have been recorded
+     */
+    int64 recordedMicros(unsigned int frameIndex) const;
+
+    /**
+     * checks the header of a file without mapping it
+     * @param path the path of a file
+     * @return true if the file has been written by a RawFrameRecorder
+     */
+    static bool isRawFrameFile(std::string path);
+};
+
+#endif /* MMAPFRAMESOURCE_HPP_ */
@@ -0,0 +1,43 @@
+#ifndef RAWFRAMEFORMAT_HPP_
+#define RAWFRAMEFORMAT_HPP_
+
+#include <stdint.h>
+
+/**
+ * The raw frame format stores uncompressed grayscale frames of a recorded
+ * session. a file consists of
+ * <ul>
+ *  <li>a RawFrameHeader</li>
+ *  <li>the pixels of all frames (width * height bytes each, rows without padding)</li>
+ *  <li>the index: one RawFrameIndexEntry per frame</li>
+ * </ul>
+ * all numbers are stored in the byte order of the recording machine.
+ * @see RawFrameRecorder
+ * @see MmapFrameSource
+ */
+
+/// the magic bytes at the beginning of every raw frame file
+#define RAW_FRAME_MAGIC "GAZERAW"
+/// the version of the file format
+#define RAW_FRAME_VERSION 1
+
+struct RawFrameHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t width;
+    uint32_t height;
+    uint32_t frameCount;
+    /// the file offset of the index
+    uint64_t indexOffset;
+};
+
+struct RawFrameIndexEntry {
+    /// the file offset of the pixels of this frame
+    uint64_t offset;
+    /// the capture time relative to the first frame in microseconds
+    int64_t captureMicros;
+    /// the sequence number of the frame in the recorded session
+    uint64_t sequenceNumber;
+};
+
+#endif /* RAWFRAMEFORMAT_HPP_ */
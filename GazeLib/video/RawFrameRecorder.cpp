@@ -0,0 +1,88 @@
+#include <cstring>
+
+#include "RawFrameRecorder.hpp"
+#include "../exception/GazeExceptions.hpp"
+
+using namespace std;
+using namespace cv;
+
+RawFrameRecorder::RawFrameRecorder(string path) : offset(sizeof (RawFrameHeader)),
+firstCaptureTick(0) {
+    file = fopen(path.c_str(), "wb");
+    if (file == NULL)
+        throw GazeException("Could not create the recording " + path);
+
+    memset(&header, 0, sizeof (header));
+    strncpy(header.magic, RAW_FRAME_MAGIC, sizeof (header.magic));
+    header.version = RAW_FRAME_VERSION;
+
+    // reserve the space for the header, it is written on close()
+    if (fwrite(&header, sizeof (header), 1, file) != 1) {
+        fclose(file);
+        throw GazeException("Could not write the recording " + path);
+    }
+}
+
+RawFrameRecorder::~RawFrameRecorder() {
+    try {
+        close();
+    } catch (GazeException &e) {
+        // already logged by the GazeException
+    }
+}
+
+void RawFrameRecorder::write(const Mat& frame, const FrameInfo& frameInfo) {
+    if (file == NULL)
+        throw WrongArgumentException("The recording has already been closed");
+
+    if (frame.type() != CV_8UC1)
+        throw WrongArgumentException("Only grayscale frames can be recorded");
+
+    if (index.empty()) {
+        header.width = frame.cols;
+        header.height = frame.rows;
+        firstCaptureTick = frameInfo.captureTick;
+    } else if ((uint32_t) frame.cols != header.width
+            || (uint32_t) frame.rows != header.height) {
+        throw WrongArgumentException("All frames of a recording must have the same size");
+    }
+
+    // write row by row, the frame might be a (non continuous) region
+    for (int row = 0; row < frame.rows; ++row) {
+        if (fwrite(frame.ptr(row), frame.cols, 1, file) != 1)
+            throw GazeException("Could not write the frame into the recording");
+    }
+
+    RawFrameIndexEntry entry;
+    entry.offset = offset;
+    entry.captureMicros = (frameInfo.captureTick - firstCaptureTick) * 1000000.
+            / getTickFrequency();
+    entry.sequenceNumber = frameInfo.sequenceNumber;
+    index.push_back(entry);
+
+    offset += (uint64_t) header.width * header.height;
+}
+
+void RawFrameRecorder::close() {
+    if (file == NULL)
+        return;
+
+    header.frameCount = index.size();
+    header.indexOffset = offset;
+
+    bool written = index.empty()
+            || fwrite(&index[0], sizeof (RawFrameIndexEntry), index.size(), file) == index.size();
+
+    written = written && fseek(file, 0, SEEK_SET) == 0
+            && fwrite(&header, sizeof (header), 1, file) == 1;
+
+    written = (fclose(file) == 0) && written;
+    file = NULL;
+
+    if (!written)
+        throw GazeException("Could not finish the recording");
+}
+
+unsigned int RawFrameRecorder::frameCount() const {
+    return index.size();
+}
@@ -0,0 +1,70 @@
+#ifndef RAWFRAMERECORDER_HPP_
+#define RAWFRAMERECORDER_HPP_
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "opencv2/core/core.hpp"
+
+#include "RawFrameFormat.hpp"
+#include "FrameInfo.hpp"
+
+/**
+ * The RawFrameRecorder writes grayscale frames into a raw frame file.
+ * these files can be replayed with the MmapFrameSource without decoding.
+ * <br />all frames of a recording must have the same size.
+ *
+ * usage:
+ * <pre>
+ * RawFrameRecorder recorder("session.raw");
+ * while (source.nextGrayFrame(frame))
+ *     recorder.write(frame, source.lastFrameInfo());
+ * recorder.close();
+ * </pre>
+ * @see RawFrameFormat.hpp
+ */
+class RawFrameRecorder {
+private:
+    FILE *file;
+    RawFrameHeader header;
+    std::vector<RawFrameIndexEntry> index;
+    uint64_t offset;
+    int64 firstCaptureTick;
+
+    RawFrameRecorder(const RawFrameRecorder&);
+    RawFrameRecorder& operator=(const RawFrameRecorder&);
+public:
+    /**
+     * creates (or overwrites) the file at the given path
+     * @param path the path of the raw frame file
+     * @throws GazeException if the file cannot be created
+     */
+    RawFrameRecorder(std::string path);
+
+    /**
+     * closes the recording if this has not been done yet
+     */
+    ~RawFrameRecorder();
+
+    /**
+     * appends a frame to the recording
+     * @param frame a grayscale frame (CV_8UC1)
+     * @param frameInfo the capture time and sequence number of the frame
+     * @throws WrongArgumentException if the frame is not a grayscale image or
+     *  its size differs from the first frame
+     */
+    void write(const cv::Mat& frame, const FrameInfo& frameInfo);
+
+    /**
+     * writes the index and the header. no more frames can be written afterwards
+     */
+    void close();
+
+    /**
+     * @return the number of frames written so far
+     */
+    unsigned int frameCount() const;
+};
+
+#endif /* RAWFRAMERECORDER_HPP_ */
@@ -0,0 +1,115 @@
+#include <cmath>
+
+#include "opencv2/imgproc/imgproc.hpp"
+
+#include "SyntheticEyeSource.hpp"
+
+using namespace std;
+using namespace cv;
+
+// the gray values of the rendered image
+static const int SKIN_INTENSITY = 140;
+static const int SCLERA_INTENSITY = 190;
+static const int IRIS_INTENSITY = 100;
+static const int PUPIL_INTENSITY = 25;
+static const int GLINT_INTENSITY = 255;
+
+// circles are drawn with 4 fractional bits, so sub pixel positions are kept
+static const int SHIFT = 4;
+static const float SCALE = 1 << SHIFT;
+
+static void drawDisc(Mat& image, const Point2f& center, float radius, int intensity) {
+    circle(image, Point(cvRound(center.x * SCALE), cvRound(center.y * SCALE)),
+            cvRound(radius * SCALE), Scalar(intensity), -1, CV_AA, SHIFT);
+}
+
+SyntheticEyeSource::SyntheticEyeSource(const SyntheticEyeConfig& config) :
+config(config), rng(config.seed) {
+}
+
+SyntheticEyeSource::~SyntheticEyeSource() {
+}
+
+const SyntheticEyeConfig& SyntheticEyeSource::getConfig() const {
+    return config;
+}
+
+Point2f SyntheticEyeSource::eyeCenter(unsigned long frameIndex) const {
+    // the head moves slower than the eye and not in sync with the gaze path
+    double phase = 2 * CV_PI * frameIndex / config.framesPerCycle;
+    return Point2f(config.resolution.width / 2.f + config.headAmplitude.width * sin(phase / 3.7),
+            config.resolution.height / 2.f + config.headAmplitude.height * sin(phase / 2.3));
+}
+
+EyeGroundTruth SyntheticEyeSource::groundTruth(unsigned long sequenceNumber) const {
+    unsigned long frameIndex = sequenceNumber > 0 ? sequenceNumber - 1 : 0;
+    double phase = 2 * CV_PI * frameIndex / config.framesPerCycle;
+
+    EyeGroundTruth truth;
+    // the glints are reflections on the cornea, they move with the head only
+    truth.glintCenter = eyeCenter(frameIndex);
+
+    // the gaze path is a figure eight
+    truth.pupilCenter = truth.glintCenter
+            + Point2f(config.gazeAmplitude.width * sin(phase),
+            config.gazeAmplitude.height * sin(2 * phase));
+    truth.pupilRadius = config.pupilRadius;
+
+    const Size2f& offset = config.glintOffset;
+    truth.glints.push_back(truth.glintCenter + Point2f(-offset.width, -offset.height));
+    truth.glints.push_back(truth.glintCenter + Point2f(offset.width, -offset.height));
+    truth.glints.push_back(truth.glintCenter + Point2f(offset.width, offset.height));
+    truth.glints.push_back(truth.glintCenter + Point2f(-offset.width, offset.height));
+
+    truth.gazeVector = truth.glintCenter - truth.pupilCenter;
+
+    return truth;
+}
+
+void SyntheticEyeSource::render(const EyeGroundTruth& truth) {
+    canvas.create(config.resolution, CV_8UC1);
+    canvas.setTo(Scalar(SKIN_INTENSITY));
+
+    // the eye (and the cornea) is centered at the glints
+    const Point2f& eye = truth.glintCenter;
+    Point center(cvRound(eye.x * SCALE), cvRound(eye.y * SCALE));
+    Size axes(cvRound(config.irisRadius * 2.6 * SCALE), cvRound(config.irisRadius * 1.3 * SCALE));
+    ellipse(canvas, center, axes, 0, 0, 360, Scalar(SCLERA_INTENSITY), -1, CV_AA, SHIFT);
+
+    drawDisc(canvas, truth.pupilCenter, config.irisRadius, IRIS_INTENSITY);
+    drawDisc(canvas, truth.pupilCenter, truth.pupilRadius, PUPIL_INTENSITY);
+
+    for (unsigned int i = 0; i < truth.glints.size(); ++i)
+        drawDisc(canvas, truth.glints[i], config.glintRadius, GLINT_INTENSITY);
+
+    if (config.blurSize > 1)
+        GaussianBlur(canvas, canvas, Size(config.blurSize, config.blurSize), 0);
+
+    if (config.noiseSigma > 0) {
+        noise.create(config.resolution, CV_16SC1);
+        rng.fill(noise, RNG::NORMAL, Scalar(0), Scalar(config.noiseSigma));
+        add(canvas, noise, canvas, noArray(), CV_8U);
+    }
+}
+
+bool SyntheticEyeSource::nextGrayFrame(cv::Mat& frame) {
+    if (config.numOfFrames > 0 && sequenceNumber >= config.numOfFrames)
+        return false;
+
+    ++sequenceNumber;
+    int64 captureTick = getTickCount();
+
+    EyeGroundTruth truth = groundTruth(sequenceNumber);
+    render(truth);
+
+    // only the region of interest is copied
+    Rect region = regionIn(canvas.size());
+    Mat& gray = grayBufferFor(frame);
+    canvas(region).copyTo(gray);
+    if (&gray != &frame)
+        frame = gray;
+
+    frameCaptured(captureTick, canvas.size(), region);
+
+    return true;
+}
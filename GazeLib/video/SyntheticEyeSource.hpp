@@ -0,0 +1,118 @@
+#ifndef SYNTHETICEYESOURCE_HPP_
+#define SYNTHETICEYESOURCE_HPP_
+
+#include <vector>
+
+#include "opencv2/core/core.hpp"
+
+#include "ImageSource.hpp"
+
+/**
+ * the parameters of the images rendered by the SyntheticEyeSource. the
+ * defaults match the GazeConfig defaults (glint distance, thresholds)
+ */
+struct SyntheticEyeConfig {
+    /// the size of the rendered frames
+    cv::Size resolution;
+    /// the radius of the pupil in pixels
+    float pupilRadius;
+    /// the radius of the iris in pixels
+    float irisRadius;
+    /// half the width and half the height of the rectangle formed by the glints
+    cv::Size2f glintOffset;
+    /// the radius of a single glint in pixels
+    float glintRadius;
+    /// the maximum distance between the pupil and the glint center
+    cv::Size2f gazeAmplitude;
+    /// the maximum distance the whole eye moves away from the frame center
+    cv::Size2f headAmplitude;
+    /// the number of frames in one cycle of the (figure eight) gaze path
+    unsigned int framesPerCycle;
+    /// the standard deviation of the gaussian noise (0 for no noise)
+    double noiseSigma;
+    /// the size of the gaussian blur kernel (0 for no blur, must be odd)
+    int blurSize;
+    /// the number of frames to deliver (0 for an endless source)
+    unsigned long numOfFrames;
+    /// the seed of the noise, equal seeds give equal frames
+    uint64 seed;
+
+    SyntheticEyeConfig() : resolution(640, 480), pupilRadius(18), irisRadius(45),
+    glintOffset(14, 9), glintRadius(3), gazeAmplitude(25, 12),
+    headAmplitude(40, 20), framesPerCycle(120), noiseSigma(4), blurSize(5),
+    numOfFrames(0), seed(0x6a7e) {
+    }
+};
+
+/**
+ * the true position of the pupil and the glints in a synthetic frame (in
+ * full frame coordinates)
+ */
+struct EyeGroundTruth {
+    cv::Point2f pupilCenter;
+    float pupilRadius;
+    /// the four glints (top left, top right, bottom right, bottom left)
+    std::vector<cv::Point2f> glints;
+    /// the center of the glint rectangle
+    cv::Point2f glintCenter;
+    /// glintCenter - pupilCenter, the GazeVector the GazeTracker should measure
+    cv::Point2f gazeVector;
+};
+
+/**
+ * The SyntheticEyeSource renders images of an eye: a dark pupil inside an
+ * iris, four rectangularly aligned glints, blur and noise. the pupil follows
+ * a scripted gaze path while the whole eye moves slowly (head motion).
+ * <br />the ground truth of every frame is known, so the source can be used
+ * to measure the accuracy and the speed of Starburst, FindGlints or the
+ * GazeTracker without any video files or cameras. the frames are
+ * deterministic: two sources with the same config deliver the same frames.
+ * <br />the images contain no face, the haar classifier of FindEyeRegion
+ * will not find an eye region in them.
+ *
+ * usage:
+ * <pre>
+ * SyntheticEyeSource source;
+ * while (source.nextGrayFrame(frame)) {
+ *     EyeGroundTruth truth = source.groundTruth(source.lastFrameInfo().sequenceNumber);
+ *     ...
+ * }
+ * </pre>
+ */
+class SyntheticEyeSource : public ImageSource {
+private:
+    SyntheticEyeConfig config;
+    cv::RNG rng;
+    /// the rendered full frame (reused for every frame)
+    cv::Mat canvas;
+    /// the noise added to the canvas (reused for every frame)
+    cv::Mat noise;
+
+    cv::Point2f eyeCenter(unsigned long frameIndex) const;
+    void render(const EyeGroundTruth& truth);
+
+public:
+    /**
+     * @param config the parameters of the rendered images
+     */
+    SyntheticEyeSource(const SyntheticEyeConfig& config = SyntheticEyeConfig());
+    virtual ~SyntheticEyeSource();
+
+    /**
+     * renders the next frame. the frames are rendered on demand, so no frames
+     * are ever dropped
+     * @param frame the next frame
+     * @return false if config.numOfFrames frames have been delivered
+     */
+    virtual bool nextGrayFrame(cv::Mat& frame);
+
+    /**
+     * @param sequenceNumber the sequence number of a frame (see FrameInfo)
+     * @return the true pupil and glint positions in this frame
+     */
+    EyeGroundTruth groundTruth(unsigned long sequenceNumber) const;
+
+    const SyntheticEyeConfig& getConfig() const;
+};
+
+#endif /* SYNTHETICEYESOURCE_HPP_ */
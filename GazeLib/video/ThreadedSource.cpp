@@ -0,0 +1,135 @@
+#include <algorithm>
+
+#include "ThreadedSource.hpp"
+#include "../utils/log.hpp"
+
+using namespace std;
+using namespace cv;
+
+ThreadedSource::ThreadedSource(ImageSource& source, DeliveryPolicy policy,
+        unsigned int numOfBuffers) :
+source(source), buffers(max(numOfBuffers, 3u)),
+frameInfos(buffers.size()), delivered(-1), regionChanged(false), running(true),
+sourceClosed(false) {
+    deliveryPolicy = policy;
+    start();
+}
+
+ThreadedSource::~ThreadedSource() {
+    mutex.lock();
+    running = false;
+    bufferFree.broadcast();
+    mutex.unlock();
+
+    join();
+}
+
+void ThreadedSource::setDeliveryPolicy(DeliveryPolicy policy) {
+    ScopedLock lock(mutex);
+    deliveryPolicy = policy;
+    dropStaleFrames();
+}
+
+void ThreadedSource::setRegionOfInterest(const cv::Rect& roi) {
+    ScopedLock lock(mutex);
+    regionOfInterest = roi;
+    regionChanged = true;
+}
+
+int ThreadedSource::nextFreeBuffer() const {
+    for (unsigned int i = 0; i < buffers.size(); ++i) {
+        if ((int) i != delivered && find(ready.begin(), ready.end(), (int) i) == ready.end())
+            return i;
+    }
+    return -1;
+}
+
+void ThreadedSource::dropStaleFrames() {
+    if (deliveryPolicy != DELIVER_LATEST_FRAME)
+        return;
+
+    // only keep the newest frame, the dropped ones show up as a gap in
+    // the sequence numbers
+    while (ready.size() > 1)
+        ready.pop_front();
+
+    bufferFree.signal();
+}
+
+void ThreadedSource::run() {
+
+    while (true) {
+        int current;
+        Rect roi;
+        bool changeRegion;
+        {
+            ScopedLock lock(mutex);
+            // with DELIVER_LATEST_FRAME there is always a free buffer
+            while (running && (current = nextFreeBuffer()) < 0)
+                bufferFree.wait(mutex);
+
+            if (!running)
+                break;
+
+            roi = regionOfInterest;
+            changeRegion = regionChanged;
+            regionChanged = false;
+        }
+
+        // the wrapped source is only touched by the capture thread
+        if (changeRegion)
+            source.setRegionOfInterest(roi);
+
+        // nobody else touches this buffer until we publish it. if a client
+        // still uses the old pixels we must not overwrite them
+        Mat& buffer = buffers.at(current);
+        if (isShared(buffer))
+            buffer.release();
+
+        bool hasFrame = false;
+        try {
+            hasFrame = source.nextGrayFrame(buffer);
+        } catch (std::exception &e) {
+            // the capture thread must not end the process, the clients
+            // see a closed source
+            LOG_W("ThreadedSource: the source has failed: " << e.what());
+        }
+
+        ScopedLock lock(mutex);
+        if (!hasFrame) {
+            LOG_W("ThreadedSource: the source has no more frames");
+            sourceClosed = true;
+            frameReady.broadcast();
+            break;
+        }
+
+        frameInfos.at(current) = source.lastFrameInfo();
+        ready.push_back(current);
+        dropStaleFrames();
+        frameReady.signal();
+    }
+}
+
+bool ThreadedSource::nextGrayFrame(cv::Mat& frame) {
+    // drop our reference first, this allows the capture thread to reuse
+    // the buffer without reallocating it
+    frame.release();
+
+    ScopedLock lock(mutex);
+    delivered = -1;
+    bufferFree.signal();
+
+    while (ready.empty() && !sourceClosed)
+        frameReady.wait(mutex);
+
+    if (ready.empty())
+        return false;
+
+    delivered = ready.front();
+    ready.pop_front();
+    frame = buffers.at(delivered);
+    frameInfo = frameInfos.at(delivered);
+    sequenceNumber = frameInfo.sequenceNumber;
+
+    return true;
+}
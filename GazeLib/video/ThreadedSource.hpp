@@ -0,0 +1,96 @@
+#ifndef THREADEDSOURCE_HPP_
+#define THREADEDSOURCE_HPP_
+
+#include <vector>
+#include <deque>
+
+#include "opencv2/core/core.hpp"
+
+#include "ImageSource.hpp"
+#include "../utils/threads.hpp"
+
+/**
+ * The ThreadedSource decouples the frame capturing from the image processing.
+ * a dedicated thread reads the frames of another ImageSource (usually a
+ * LiveSource) into a small ring of buffers. nextGrayFrame() does not wait for
+ * the camera but just hands over the newest frame that is ready.
+ * <br />this way the capture time and the processing time in the GazeTracker
+ * do not add up any more and the camera can run at its full frame rate.
+ *
+ * the frame returned by nextGrayFrame() stays valid until the next call to
+ * nextGrayFrame(). buffers which are still referenced by a client (e.g. an
+ * image which has been passed to the GUI) are never overwritten.
+ * <br />with DELIVER_EVERY_FRAME the frames are queued in the ring buffer and
+ * the capture thread waits if the ring is full.
+ *
+ * usage:
+ * <pre>
+ * LiveSource camera;
+ * ThreadedSource source(camera);
+ * GazeTracker tracker(source, callback);
+ * </pre>
+ */
+class ThreadedSource : public ImageSource, private Thread {
+private:
+    ImageSource& source;
+
+    std::vector<cv::Mat> buffers;
+    /// the descriptions of the frames in the buffers
+    std::vector<FrameInfo> frameInfos;
+    /// the buffers holding frames which have not been delivered yet (oldest first)
+    std::deque<int> ready;
+    /// the buffer that has been handed over to the client (or -1)
+    int delivered;
+    /// set if the client changed the region of interest since the last frame
+    bool regionChanged;
+
+    bool running;
+    bool sourceClosed;
+
+    Mutex mutex;
+    Condition frameReady;
+    Condition bufferFree;
+
+    int nextFreeBuffer() const;
+    void dropStaleFrames();
+
+protected:
+    void run();
+
+public:
+    /**
+     * creates a ThreadedSource and starts capturing immediately
+     * @param source the ImageSource to read the frames from. the source must
+     *  not be used by anybody else while the ThreadedSource exists
+     * @param policy whether stale frames should be dropped or queued
+     * @param numOfBuffers the size of the ring buffer (at least 3)
+     */
+    ThreadedSource(ImageSource& source,
+            DeliveryPolicy policy = DELIVER_LATEST_FRAME,
+            unsigned int numOfBuffers = 3);
+
+    /**
+     * stops the capture thread. this may block until the wrapped source
+     * returned its current frame
+     */
+    virtual ~ThreadedSource();
+
+    /**
+     * blocks until a new frame is available and returns it
+     * @param frame the next frame (the newest one with DELIVER_LATEST_FRAME)
+     * @return false if the wrapped source has no more frames
+     */
+    virtual bool nextGrayFrame(cv::Mat& frame);
+
+    virtual void setDeliveryPolicy(DeliveryPolicy policy);
+
+    /**
+     * forwards the region of interest to the wrapped source before it
+     * captures the next frame. the frames which are already in the ring
+     * buffer keep their region.
+     * @param roi the window in full frame coordinates
+     */
+    virtual void setRegionOfInterest(const cv::Rect& roi);
+};
+
+#endif /* THREADEDSOURCE_HPP_ */
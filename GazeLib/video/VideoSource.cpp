@@ -7,8 +7,13 @@
 using namespace std;
 using namespace cv;
 
-VideoSource::VideoSource(string videoPath) {
+VideoSource::VideoSource(string videoPath) : startTick(0) {
 	videoCapture = new VideoCapture(videoPath);
+
+	fps = videoCapture->get(CV_CAP_PROP_FPS);
+	// some containers do not report their frame rate
+	if (fps <= 0)
+		fps = 30;
 }
 
 VideoSource::~VideoSource() {
@@ -24,16 +29,64 @@ bool VideoSource::nextGrayFrame(cv::Mat& frame) {
 		return false;
 
 	// Check if there are more frames
-	if (!videoCapture->read(frame))
+	if (deliveryPolicy == DELIVER_LATEST_FRAME) {
+		if (!skipToCurrentFrame())
+			return false;
+	} else {
+		if (!videoCapture->grab())
+			return false;
+		++sequenceNumber;
+	}
+	int64 captureTick = getTickCount();
+
+	if (!videoCapture->retrieve(rawFrame))
 		return false;
 
 	 // Check for invalid input
-	if (!frame.data)
+	if (!rawFrame.data)
 		return false;
 
-	// Convert to grayscale
-	cvtColor(frame, frame, CV_BGR2GRAY);
+	// Convert to grayscale, only the region of interest
+	Rect region = regionIn(rawFrame.size());
+	Mat& gray = grayBufferFor(frame);
+	toGray(rawFrame(region), gray);
+	if (&gray != &frame)
+		frame = gray;
+
+	frameCaptured(captureTick, rawFrame.size(), region);
+
+	return true;
+}
+
+
+unsigned long VideoSource::frameCount() const {
+	double count = videoCapture->get(CV_CAP_PROP_FRAME_COUNT);
+	return count > 0 ? count : 0;
+}
+
+bool VideoSource::seek(unsigned long frameIndex) {
+	if (!videoCapture->set(CV_CAP_PROP_POS_FRAMES, frameIndex))
+		return false;
 
+	sequenceNumber = frameIndex;
+	startTick = 0;
 	return true;
 }
 
+bool VideoSource::skipToCurrentFrame() {
+	if (startTick == 0)
+		startTick = getTickCount();
+
+	// the frame a camera would deliver right now
+	double seconds = (getTickCount() - startTick) / getTickFrequency();
+	unsigned long currentFrame = seconds * fps + 1;
+
+	// grab at least one frame, skip the ones we are too late for
+	do {
+		if (!videoCapture->grab())
+			return false;
+		++sequenceNumber;
+	} while (sequenceNumber < currentFrame);
+
+	return true;
+}
@@ -9,10 +9,24 @@
 /**
  * The VideoSource class provides acces to images within an video file.
  * this class can be used to mock/test the GazeLib algorithms
+ * <br />with DELIVER_LATEST_FRAME the video is replayed in real time: frames
+ * which a slow client could not have processed in time are skipped, just
+ * like a camera would drop them.
+ * <br />the decoded frames and the gray frames are written into reused
+ * buffers, so replaying a video does not allocate memory for every frame.
+ * if a region of interest is set only this window is converted.
  */
 class VideoSource: public ImageSource {
 private:
 	cv::VideoCapture *videoCapture;
+	/// the decoded frame (reused for every frame)
+	cv::Mat rawFrame;
+	/// the tick count when the first frame was delivered
+	int64 startTick;
+	/// frames per second of the video (used for the real time replay)
+	double fps;
+
+	bool skipToCurrentFrame();
 public:
     /**
      * creates a VideoSource and opens the file at the given path
@@ -21,6 +35,20 @@ public:
 	VideoSource(std::string videoPath);
 	~VideoSource();
 	virtual bool nextGrayFrame(cv::Mat& frame);
+
+	/**
+	 * @return the number of frames in the video as reported by the container
+	 *  (0 if unknown, some containers only report an estimate)
+	 */
+	unsigned long frameCount() const;
+
+	/**
+	 * continues the video at the given frame. the sequence number of this
+	 * frame will be frameIndex + 1
+	 * @param frameIndex the index of the next frame (0 is the first frame)
+	 * @return false if the video cannot seek
+	 */
+	bool seek(unsigned long frameIndex);
 };
 
 
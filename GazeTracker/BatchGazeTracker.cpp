@@ -0,0 +1,214 @@
+/*
+ * BatchGazeTracker.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *
+ * measures a recorded session (a video or a raw frame file) on all cores and
+ * writes the gaze trace as CSV. this is a separate executable, it is built
+ * by the "Batch" configuration of this project.
+ * "BatchGazeTracker --eye-locators <recording>" compares the haar cascades
+ * and the GlintPatternLocator on every frame of the recording instead.
+ */
+
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+#include "opencv2/core/core.hpp"
+
+#include "detection/BatchTracker.hpp"
+#include "detection/eye/FindEyeRegion.hpp"
+#include "video/MmapFrameSource.hpp"
+#include "video/VideoSource.hpp"
+#include "exception/GazeExceptions.hpp"
+#include "utils/latency.hpp"
+
+using namespace std;
+using namespace cv;
+
+static void writeTrace(ostream& out, const vector<GazeSample>& trace) {
+    out << "frame,sequence,measured,result,gaze_x,gaze_y" << endl;
+    for (unsigned int i = 0; i < trace.size(); ++i) {
+        const GazeSample& sample = trace[i];
+        out << sample.frameIndex << "," << sample.frameInfo.sequenceNumber << ","
+                << sample.measured << "," << sample.result << ","
+                << sample.gazeVector.x << "," << sample.gazeVector.y << endl;
+    }
+}
+
+static double millisSince(int64 startTick) {
+    return (getTickCount() - startTick) * 1000. / getTickFrequency();
+}
+
+/**
+ * one way to find the eye, measured by benchmarkEyeLocators()
+ */
+class EyeLocatorRun {
+private:
+    FindGlints glintFinder;
+    FindEyeRegion *eyeFinder;
+
+    EyeLocatorRun(const EyeLocatorRun&);
+    EyeLocatorRun& operator=(const EyeLocatorRun&);
+
+public:
+    string name;
+    /// the time to load the cascades, and to take them from the CascadeCache
+    double loadMillis;
+    double cachedLoadMillis;
+    LatencyHistogram times;
+    unsigned long found;
+    unsigned long agreed;
+    /// the eye of the last frame
+    Rect eye;
+    bool foundEye;
+
+    /**
+     * @throws GazeException if the cascades could not be loaded
+     */
+    EyeLocatorRun(const string& name, const TrackerConfig& config) : glintFinder(config),
+    name(name), found(0), agreed(0), foundEye(false) {
+        int64 start = getTickCount();
+        eyeFinder = new FindEyeRegion(glintFinder, config);
+        loadMillis = millisSince(start);
+
+        // the next FindEyeRegion gets the classifiers given back
+        delete eyeFinder;
+        start = getTickCount();
+        eyeFinder = new FindEyeRegion(glintFinder, config);
+        cachedLoadMillis = millisSince(start);
+    }
+
+    ~EyeLocatorRun() {
+        delete eyeFinder;
+    }
+
+    void measure(const Mat& frame) {
+        // the frame is not written, findEye() only wants a Mat&
+        Mat image = frame;
+        int64 start = getTickCount();
+        foundEye = eyeFinder->findEye(image, eye);
+        times.record(millisSince(start) * 1000);
+        found += foundEye;
+    }
+
+    /**
+     * counts the frames in which the eye of the other run is this eye
+     */
+    void compareWith(const EyeLocatorRun& other) {
+        Point center(eye.x + eye.width / 2, eye.y + eye.height / 2);
+        if (foundEye && other.foundEye && other.eye.contains(center))
+            ++agreed;
+    }
+
+    void print(unsigned long frames, const string& reference) const {
+        cout << name << ": loaded in " << loadMillis << "ms (" << cachedLoadMillis
+                << "ms from the cache), found in " << found << " of " << frames
+                << " frames, mean " << times.mean() / 1000 << "ms, p95 "
+                << times.percentile(95) / 1000. << "ms, max " << times.max() / 1000.
+                << "ms";
+        if (name != reference)
+            cout << ", same eye as the " << reference << " in " << agreed << " frames";
+        cout << endl;
+    }
+};
+
+/**
+ * searches the eye in every frame of the recording with the haar cascades
+ * and the GlintPatternLocator
+ */
+static int benchmarkEyeLocators(const string& recording) {
+    ImageSource *source;
+    if (MmapFrameSource::isRawFrameFile(recording))
+        source = new MmapFrameSource(recording);
+    else
+        source = new VideoSource(recording);
+
+    TrackerConfig haarConfig;
+    haarConfig.locateEyesByGlints = false;
+    TrackerConfig glintConfig = haarConfig;
+    glintConfig.locateEyesByGlints = true;
+
+    vector<EyeLocatorRun*> runs;
+    runs.push_back(new EyeLocatorRun("haar cascades", haarConfig));
+    runs.push_back(new EyeLocatorRun("glint pattern", glintConfig));
+
+    unsigned long frames = 0;
+    Mat frame;
+    while (source->nextGrayFrame(frame)) {
+        ++frames;
+        for (unsigned int i = 0; i < runs.size(); ++i) {
+            runs[i]->measure(frame);
+            runs[i]->compareWith(*runs.front());
+        }
+    }
+
+    for (unsigned int i = 0; i < runs.size(); ++i) {
+        runs[i]->print(frames, runs.front()->name);
+        delete runs[i];
+    }
+    delete source;
+    return 0;
+}
+
+int main(int argc, char** argv) {
+
+    if (argc < 2) {
+        cerr << "usage: " << argv[0] << " <recording> [<trace.csv>] [<workers>]" << endl
+                << "       " << argv[0] << " --eye-locators <recording>" << endl;
+        return 1;
+    }
+
+    if (strcmp(argv[1], "--eye-locators") == 0) {
+        if (argc < 3) {
+            cerr << "usage: " << argv[0] << " --eye-locators <recording>" << endl;
+            return 1;
+        }
+
+        try {
+            return benchmarkEyeLocators(argv[2]);
+        } catch (GazeException &e) {
+            cerr << e.what() << endl;
+            return 1;
+        }
+    }
+
+    string recording = argv[1];
+    unsigned int workers = (argc > 3) ? atoi(argv[3]) : 0;
+
+    try {
+        BatchTracker batch(recording, workers);
+        // the trace may go to stdout, everything else goes to stderr
+        cerr << recording << ": " << batch.frameCount() << " frames, "
+                << batch.workerCount() << " workers" << endl;
+
+        vector<GazeSample> trace;
+        int64 start = getTickCount();
+        batch.process(trace);
+        double seconds = (getTickCount() - start) / getTickFrequency();
+
+        unsigned long measured = 0;
+        for (unsigned int i = 0; i < trace.size(); ++i)
+            if (trace[i].measured && trace[i].result == MEASURE_OK)
+                ++measured;
+
+        cerr << "processed in " << seconds << "s (" << trace.size() / seconds
+                << " fps), " << measured << " gaze vectors" << endl;
+
+        StageTimings::print(cerr);
+
+        if (argc > 2) {
+            ofstream out(argv[2]);
+            writeTrace(out, trace);
+        } else {
+            writeTrace(cout, trace);
+        }
+    } catch (GazeException &e) {
+        cerr << e.what() << endl;
+        return 1;
+    }
+
+    return 0;
+}
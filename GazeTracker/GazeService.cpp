@@ -0,0 +1,177 @@
+/*
+ * GazeService.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *
+ * the headless gaze service: tracks the camera (or a video) without any
+ * window and publishes the gaze samples into a shared memory ring, where any
+ * number of local clients read them with a GazeStreamReader. a slow client
+ * never slows down the tracking.
+ * "GazeService --read" is such a client, it prints the samples of a running
+ * service as CSV. this is a separate executable, it is built by the
+ * "Service" configuration of this project.
+ * with "--fps <rate>" the service lowers the quality of the pupil search
+ * while the machine is too busy to keep this gaze rate.
+ */
+
+#include <csignal>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+
+#include "opencv2/core/core.hpp"
+
+#include "detection/GazeTracker.hpp"
+#include "service/GazeStreamReader.hpp"
+#include "service/GazeStreamWriter.hpp"
+#include "video/LiveSource.hpp"
+#include "video/ThreadedSource.hpp"
+#include "video/VideoSource.hpp"
+#include "exception/GazeExceptions.hpp"
+#include "utils/latency.hpp"
+
+using namespace std;
+using namespace cv;
+
+static volatile sig_atomic_t stopRequested = 0;
+
+static void requestStop(int signal) {
+    stopRequested = 1;
+}
+
+/**
+ * publishes every measured frame into the gaze stream
+ */
+class StreamCallback : public TrackerCallback {
+private:
+    GazeStreamWriter& stream;
+    unsigned long droppedFrames;
+
+public:
+
+    StreamCallback(GazeStreamWriter& stream) : stream(stream), droppedFrames(0) {
+    }
+
+    virtual bool imageProcessed(Mat &resultImage) {
+        stream.setStatus(STREAM_SEARCHING);
+        return !stopRequested;
+    }
+
+    virtual bool imageProcessed(Mat &resultImage, MeasureResult &result, Point2f &gazeVector) {
+        return !stopRequested;
+    }
+
+    /// the frames are not displayed, so no overlay is rendered
+    virtual bool frameProcessed(FrameResult &frameResult) {
+        stream.publish(frameResult);
+        return !stopRequested;
+    }
+
+    virtual void framesDropped(unsigned long numOfFrames, unsigned long sequenceNumber) {
+        droppedFrames += numOfFrames;
+        stream.setDroppedFrames(droppedFrames);
+    }
+};
+
+static int serve(const string& name, const string& video, double fps) {
+    GazeStreamWriter stream(name);
+    // deleted after the tracker and the ThreadedSource which use them
+    ImageSource *source = NULL;
+    QualityController *qualityController = NULL;
+    int exitCode = 0;
+
+    try {
+        if (video.empty())
+            source = new LiveSource();
+        else
+            source = new VideoSource(video);
+
+        // capture in the background while the tracker processes the last frame
+        ThreadedSource threadedSource(*source);
+        StreamCallback callback(stream);
+        GazeTracker tracker(threadedSource, &callback);
+        tracker.setPipelined(true);
+
+        if (fps > 0) {
+            qualityController = new QualityController(1000 / fps);
+            tracker.setQualityController(qualityController);
+        }
+
+        cerr << "publishing the gaze samples to " << name << endl;
+
+        while (!stopRequested) {
+            try {
+                stream.setStatus(STREAM_SEARCHING);
+                tracker.track();
+            } catch (EyeRegionNotFoundException &e) {
+                // nobody in front of the camera, keep searching
+            }
+        }
+        StageTimings::print(cerr);
+    } catch (GazeException &e) {
+        cerr << e.what() << endl;
+        stream.setStatus(STREAM_FAILED);
+        exitCode = 1;
+    }
+
+    delete qualityController;
+    delete source;
+    return exitCode;
+}
+
+static int printStream(const string& name) {
+    GazeStreamReader reader(name);
+    GazeStreamSample sample;
+
+    cout << "sequence,capture_us,latency_us,result,gaze_x,gaze_y,confidence" << endl;
+    while (!stopRequested) {
+        if (!reader.waitForNext(sample, 1000)) {
+            if (reader.status() == STREAM_STOPPED || reader.status() == STREAM_FAILED)
+                break;
+            continue;
+        }
+
+        cout << sample.sequenceNumber << "," << sample.captureMicros << ","
+                << GazeStreamReader::nowMicros() - sample.captureMicros << ","
+                << sample.result << "," << sample.gazeX << "," << sample.gazeY << ","
+                << sample.confidence << endl;
+    }
+
+    cerr << "missed samples: " << reader.missedSamples()
+            << ", dropped frames: " << reader.droppedFrames() << endl;
+    return 0;
+}
+
+int main(int argc, char** argv) {
+    string name = GAZE_STREAM_DEFAULT_NAME;
+    string video;
+    double fps = 0;
+    bool reading = false;
+
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "--read") == 0) {
+            reading = true;
+        } else if (strcmp(argv[i], "--name") == 0 && i + 1 < argc) {
+            name = argv[++i];
+        } else if (strcmp(argv[i], "--fps") == 0 && i + 1 < argc) {
+            fps = atof(argv[++i]);
+        } else if (argv[i][0] == '-') {
+            cerr << "usage: " << argv[0] << " [--name <stream>] [--fps <rate>] [<video>]" << endl
+                    << "       " << argv[0] << " --read [--name <stream>]" << endl;
+            return 1;
+        } else {
+            video = argv[i];
+        }
+    }
+
+    signal(SIGINT, requestStop);
+    signal(SIGTERM, requestStop);
+
+    try {
+        return reading ? printStream(name) : serve(name, video, fps);
+    } catch (GazeException &e) {
+        cerr << e.what() << endl;
+        return 1;
+    }
+}
@@ -13,9 +13,11 @@
 #include "detection/pupil/Starburst.hpp"
 #include "video/VideoSource.hpp"
 #include "video/LiveSource.hpp"
+#include "video/ThreadedSource.hpp"
 #include "config/GazeConfig.hpp"
 #include "TCallback.hpp"
 #include "utils/geometry.hpp"
+#include "utils/latency.hpp"
 
 
 
@@ -33,13 +35,18 @@ int main() {
     VideoSource videoSource(path);
 
     LiveSource liveSource;
+    // capture in the background while the tracker processes the last frame
+    ThreadedSource threadedSource(liveSource);
 
     TrackerCallback* callback;
     callback = new TCallback();
     
-    GazeConfig::DETECT_LEFT_EYE = false;
+    TrackerConfig config;
+    config.detectLeftEye = false;
 
-    GazeTracker tracker(liveSource, callback);
+    GazeTracker tracker(threadedSource, callback, config);
+    // search the glints and the pupil on separate threads
+    tracker.setPipelined(true);
 
 
 
@@ -52,6 +59,7 @@ int main() {
     cout << "Done initializing " << endl;
     cout << "----------------- " << endl;
     cout << "----------------- " << endl;
+    StageTimings::print(cout);
     delete callback;
 
 }
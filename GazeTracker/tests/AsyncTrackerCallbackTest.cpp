@@ -0,0 +1,204 @@
+/*
+ * File:   AsyncTrackerCallbackTest.cpp
+ *
+ * Created on Oct 17, 2026, 4:08:12 PM
+ */
+
+#include <unistd.h>
+
+#include <vector>
+
+#include "AsyncTrackerCallbackTest.h"
+#include "detection/AsyncTrackerCallback.hpp"
+#include "utils/LockFreeQueue.hpp"
+#include "utils/threads.hpp"
+
+using namespace std;
+
+CPPUNIT_TEST_SUITE_REGISTRATION(AsyncTrackerCallbackTest);
+
+/**
+ * pushes the numbers 1..numOfItems, retries while the queue is full
+ */
+class Producer : public Thread {
+private:
+    LockFreeQueue<int>& queue;
+    int numOfItems;
+
+protected:
+
+    void run() {
+        for (int i = 1; i <= numOfItems; ++i) {
+            while (!queue.tryPush(i))
+                usleep(10);
+        }
+        queue.close();
+    }
+
+public:
+
+    Producer(LockFreeQueue<int>& queue, int numOfItems) :
+    queue(queue), numOfItems(numOfItems) {
+    }
+
+    ~Producer() {
+        join();
+    }
+};
+
+/**
+ * remembers the delivered frames, optionally takes its time for each one
+ */
+class RecordingCallback : public TrackerCallback {
+public:
+    vector<unsigned long> sequenceNumbers;
+    unsigned long droppedFrames;
+    unsigned long lastDroppedBefore;
+    unsigned int delayMicros;
+    bool answer;
+
+    RecordingCallback() : droppedFrames(0), lastDroppedBefore(0),
+    delayMicros(0), answer(true) {
+    }
+
+    bool imageProcessed(Mat &resultImage) {
+        return answer;
+    }
+
+    bool imageProcessed(Mat &resultImage, MeasureResult &result, Point2f &gazeVector) {
+        return answer;
+    }
+
+    bool frameProcessed(FrameResult &frameResult) {
+        if (delayMicros > 0)
+            usleep(delayMicros);
+        sequenceNumbers.push_back(frameResult.frameInfo.sequenceNumber);
+        return answer;
+    }
+
+    void framesDropped(unsigned long numOfFrames, unsigned long sequenceNumber) {
+        droppedFrames += numOfFrames;
+        lastDroppedBefore = sequenceNumber;
+    }
+};
+
+static FrameResult frame(unsigned long sequenceNumber) {
+    FrameResult frameResult;
+    frameResult.result = MEASURE_OK;
+    frameResult.image = Mat::zeros(40, 60, CV_8UC1);
+    frameResult.frameInfo.sequenceNumber = sequenceNumber;
+    return frameResult;
+}
+
+AsyncTrackerCallbackTest::AsyncTrackerCallbackTest() {
+}
+
+AsyncTrackerCallbackTest::~AsyncTrackerCallbackTest() {
+}
+
+void AsyncTrackerCallbackTest::setUp() {
+}
+
+void AsyncTrackerCallbackTest::tearDown() {
+}
+
+void AsyncTrackerCallbackTest::testQueueOrder() {
+    const int numOfItems = 100000;
+    LockFreeQueue<int> queue(4);
+    Producer producer(queue, numOfItems);
+    producer.start();
+
+    int expected = 1;
+    int item;
+    while (queue.pop(item)) {
+        CPPUNIT_ASSERT_EQUAL(expected, item);
+        ++expected;
+    }
+    CPPUNIT_ASSERT_EQUAL(numOfItems + 1, expected);
+}
+
+void AsyncTrackerCallbackTest::testQueueSpace() {
+    LockFreeQueue<int> queue(2);
+    CPPUNIT_ASSERT(queue.hasSpace());
+    CPPUNIT_ASSERT(queue.tryPush(1));
+    CPPUNIT_ASSERT(queue.tryPush(2));
+    CPPUNIT_ASSERT(!queue.hasSpace());
+
+    int item;
+    CPPUNIT_ASSERT(queue.tryPop(item));
+    CPPUNIT_ASSERT(queue.hasSpace());
+
+    queue.close();
+    CPPUNIT_ASSERT(!queue.hasSpace());
+}
+
+void AsyncTrackerCallbackTest::testDelivery() {
+    RecordingCallback consumer;
+    AsyncTrackerCallback async(consumer);
+
+    for (unsigned long i = 1; i <= 5; ++i) {
+        // frame 4 was dropped by the source
+        unsigned long sequenceNumber = i < 4 ? i : i + 1;
+        if (sequenceNumber == 5)
+            async.framesDropped(1, sequenceNumber);
+
+        FrameResult frameResult = frame(sequenceNumber);
+        CPPUNIT_ASSERT(async.frameProcessed(frameResult));
+    }
+    CPPUNIT_ASSERT(async.flush());
+
+    CPPUNIT_ASSERT_EQUAL((size_t) 5, consumer.sequenceNumbers.size());
+    CPPUNIT_ASSERT_EQUAL(1ul, consumer.sequenceNumbers.front());
+    CPPUNIT_ASSERT_EQUAL(6ul, consumer.sequenceNumbers.back());
+    CPPUNIT_ASSERT_EQUAL(1ul, consumer.droppedFrames);
+    CPPUNIT_ASSERT_EQUAL(5ul, consumer.lastDroppedBefore);
+    CPPUNIT_ASSERT_EQUAL(0ul, async.getDroppedResults());
+}
+
+void AsyncTrackerCallbackTest::testSlowConsumer() {
+    const unsigned long numOfFrames = 50;
+    RecordingCallback consumer;
+    consumer.delayMicros = 20000;
+    AsyncTrackerCallback async(consumer, 4);
+
+    // the tracker does not wait for the consumer
+    int64 startTick = getTickCount();
+    for (unsigned long i = 1; i <= numOfFrames; ++i) {
+        FrameResult frameResult = frame(i);
+        async.frameProcessed(frameResult);
+    }
+    double millis = (getTickCount() - startTick) * 1000. / getTickFrequency();
+    CPPUNIT_ASSERT(millis < 100);
+
+    async.flush();
+    CPPUNIT_ASSERT(async.getDroppedResults() > 0);
+    CPPUNIT_ASSERT_EQUAL(numOfFrames, consumer.sequenceNumbers.size() + async.getDroppedResults());
+
+    // the first results made it, in order
+    CPPUNIT_ASSERT_EQUAL(1ul, consumer.sequenceNumbers.front());
+    for (size_t i = 1; i < consumer.sequenceNumbers.size(); ++i)
+        CPPUNIT_ASSERT(consumer.sequenceNumbers[i - 1] < consumer.sequenceNumbers[i]);
+}
+
+void AsyncTrackerCallbackTest::testStopTracking() {
+    RecordingCallback consumer;
+    consumer.answer = false;
+    AsyncTrackerCallback async(consumer);
+
+    FrameResult frameResult = frame(1);
+    async.frameProcessed(frameResult);
+    CPPUNIT_ASSERT(!async.flush());
+
+    // the next tracking starts with a fresh answer
+    consumer.answer = true;
+    frameResult = frame(2);
+    CPPUNIT_ASSERT(async.frameProcessed(frameResult));
+    CPPUNIT_ASSERT(async.flush());
+
+    // nothing is delivered after stop()
+    async.stop();
+    frameResult = frame(3);
+    async.frameProcessed(frameResult);
+    async.flush();
+    CPPUNIT_ASSERT_EQUAL((size_t) 2, consumer.sequenceNumbers.size());
+}
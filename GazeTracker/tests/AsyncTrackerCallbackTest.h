@@ -0,0 +1,37 @@
+/*
+ * File:   AsyncTrackerCallbackTest.h
+ *
+ * Created on Oct 17, 2026, 4:08:12 PM
+ */
+
+#ifndef ASYNCTRACKERCALLBACKTEST_H
+#define	ASYNCTRACKERCALLBACKTEST_H
+
+#include <cppunit/extensions/HelperMacros.h>
+
+class AsyncTrackerCallbackTest : public CPPUNIT_NS::TestFixture {
+    CPPUNIT_TEST_SUITE(AsyncTrackerCallbackTest);
+
+    CPPUNIT_TEST(testQueueOrder);
+    CPPUNIT_TEST(testQueueSpace);
+    CPPUNIT_TEST(testDelivery);
+    CPPUNIT_TEST(testSlowConsumer);
+    CPPUNIT_TEST(testStopTracking);
+
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+    AsyncTrackerCallbackTest();
+    virtual ~AsyncTrackerCallbackTest();
+    void setUp();
+    void tearDown();
+
+private:
+    void testQueueOrder();
+    void testQueueSpace();
+    void testDelivery();
+    void testSlowConsumer();
+    void testStopTracking();
+};
+
+#endif	/* ASYNCTRACKERCALLBACKTEST_H */
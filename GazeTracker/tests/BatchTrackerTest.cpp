@@ -0,0 +1,99 @@
+/*
+ * File:   BatchTrackerTest.cpp
+ *
+ * Created on Oct 17, 2026, 9:41:06 PM
+ */
+
+#include <cstdio>
+#include <cstring>
+#include <vector>
+#include <opencv2/core/core.hpp>
+
+#include "BatchTrackerTest.h"
+#include "detection/BatchTracker.hpp"
+#include "video/RawFrameRecorder.hpp"
+#include "video/SyntheticEyeSource.hpp"
+
+using namespace cv;
+using namespace std;
+
+CPPUNIT_TEST_SUITE_REGISTRATION(BatchTrackerTest);
+
+static const int NUM_OF_FRAMES = 240;
+/// the frames in which the eye is closed, long enough to lose the eye
+static const int BLINK_START = 100;
+static const int BLINK_END = 140;
+
+/**
+ * records synthetic frames with a long blink, so the trackers have to
+ * search the eye again
+ */
+static void record(string path) {
+    SyntheticEyeConfig eyeConfig;
+    eyeConfig.numOfFrames = NUM_OF_FRAMES;
+    SyntheticEyeSource source(eyeConfig);
+    RawFrameRecorder recorder(path);
+
+    Mat frame;
+    for (int i = 0; source.nextGrayFrame(frame); ++i) {
+        if (i >= BLINK_START && i < BLINK_END)
+            frame = Mat(frame.size(), CV_8UC1, Scalar(150));
+        recorder.write(frame, source.lastFrameInfo());
+    }
+    recorder.close();
+}
+
+static void track(string path, unsigned int numOfWorkers, vector<GazeSample>& trace) {
+    // the synthetic frames have no face, the eyes are located by their glints
+    TrackerConfig config;
+    config.locateEyesByGlints = true;
+
+    BatchTracker batch(path, numOfWorkers, 30, config);
+    batch.process(trace);
+}
+
+BatchTrackerTest::BatchTrackerTest() {
+}
+
+BatchTrackerTest::~BatchTrackerTest() {
+}
+
+void BatchTrackerTest::setUp() {
+    path = "/tmp/gazelib_batchtrackertest.raw";
+}
+
+void BatchTrackerTest::tearDown() {
+    remove(path.c_str());
+}
+
+void BatchTrackerTest::testWorkersGiveSameTrace() {
+    record(path);
+
+    vector<GazeSample> single;
+    vector<GazeSample> parallel;
+    track(path, 1, single);
+    track(path, 4, parallel);
+
+    CPPUNIT_ASSERT_EQUAL((size_t) NUM_OF_FRAMES, single.size());
+    CPPUNIT_ASSERT_EQUAL(single.size(), parallel.size());
+
+    int measured = 0;
+    for (unsigned int i = 0; i < single.size(); ++i) {
+        const GazeSample& a = single[i];
+        const GazeSample& b = parallel[i];
+        CPPUNIT_ASSERT_EQUAL(a.frameIndex, b.frameIndex);
+        CPPUNIT_ASSERT_EQUAL(a.measured, b.measured);
+        CPPUNIT_ASSERT_EQUAL(a.frameInfo.sequenceNumber, b.frameInfo.sequenceNumber);
+        if (!a.measured)
+            continue;
+
+        // the same bits, not only nearly the same gaze
+        CPPUNIT_ASSERT_EQUAL(a.result, b.result);
+        CPPUNIT_ASSERT(memcmp(&a.gazeVector, &b.gazeVector, sizeof (a.gazeVector)) == 0);
+        ++measured;
+    }
+
+    // the eye has been found before and after the blink
+    CPPUNIT_ASSERT(measured > NUM_OF_FRAMES / 2);
+    CPPUNIT_ASSERT(single[BLINK_END + 40].measured);
+}
@@ -0,0 +1,32 @@
+/*
+ * File:   BatchTrackerTest.h
+ *
+ * Created on Oct 17, 2026, 9:41:06 PM
+ */
+
+#ifndef BATCHTRACKERTEST_H
+#define	BATCHTRACKERTEST_H
+
+#include <string>
+#include <cppunit/extensions/HelperMacros.h>
+
+class BatchTrackerTest : public CPPUNIT_NS::TestFixture {
+    CPPUNIT_TEST_SUITE(BatchTrackerTest);
+
+    CPPUNIT_TEST(testWorkersGiveSameTrace);
+
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+    BatchTrackerTest();
+    virtual ~BatchTrackerTest();
+    void setUp();
+    void tearDown();
+
+private:
+    std::string path;
+
+    void testWorkersGiveSameTrace();
+};
+
+#endif	/* BATCHTRACKERTEST_H */
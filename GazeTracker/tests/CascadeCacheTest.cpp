@@ -0,0 +1,91 @@
+/*
+ * File:   CascadeCacheTest.cpp
+ *
+ * Created on Oct 17, 2026, 9:12:40 PM
+ */
+
+#include "CascadeCacheTest.h"
+#include "detection/eye/CascadeCache.hpp"
+#include "exception/GazeExceptions.hpp"
+
+using namespace cv;
+
+CPPUNIT_TEST_SUITE_REGISTRATION(CascadeCacheTest);
+
+static const char* EYE_CASCADE = "../__haarcascades/haarcascade_eye.xml";
+
+CascadeCacheTest::CascadeCacheTest() {
+}
+
+CascadeCacheTest::~CascadeCacheTest() {
+}
+
+void CascadeCacheTest::setUp() {
+}
+
+void CascadeCacheTest::tearDown() {
+}
+
+void CascadeCacheTest::testReuse() {
+    CascadeCache& cache = CascadeCache::instance();
+    unsigned int idle = cache.idleCount(EYE_CASCADE);
+
+    CascadeClassifier* classifier = cache.acquire(EYE_CASCADE);
+    CPPUNIT_ASSERT(classifier != NULL);
+    CPPUNIT_ASSERT(!classifier->empty());
+    cache.release(EYE_CASCADE, classifier);
+    CPPUNIT_ASSERT_EQUAL(idle + 1, cache.idleCount(EYE_CASCADE));
+
+    // the classifier given back is not loaded again
+    CascadeClassifier* again = cache.acquire(EYE_CASCADE);
+    CPPUNIT_ASSERT(again == classifier);
+    cache.release(EYE_CASCADE, again);
+}
+
+void CascadeCacheTest::testConcurrentUsers() {
+    CascadeCache& cache = CascadeCache::instance();
+
+    // a classifier is never lent twice
+    CascadeClassifier* first = cache.acquire(EYE_CASCADE);
+    CascadeClassifier* second = cache.acquire(EYE_CASCADE);
+    CPPUNIT_ASSERT(first != second);
+
+    cache.release(EYE_CASCADE, first);
+    cache.release(EYE_CASCADE, second);
+}
+
+void CascadeCacheTest::testLease() {
+    CascadeCache& cache = CascadeCache::instance();
+    cache.preload(EYE_CASCADE, 1);
+    unsigned int idle = cache.idleCount(EYE_CASCADE);
+
+    {
+        CascadeLease lease;
+        CPPUNIT_ASSERT(!lease.isLoaded());
+
+        lease.acquire(EYE_CASCADE);
+        CPPUNIT_ASSERT(lease.isLoaded());
+        CPPUNIT_ASSERT(!lease->empty());
+        CPPUNIT_ASSERT_EQUAL(idle - 1, cache.idleCount(EYE_CASCADE));
+
+        // the same file again keeps the classifier
+        CascadeClassifier* classifier = &*lease;
+        lease.acquire(EYE_CASCADE);
+        CPPUNIT_ASSERT(&*lease == classifier);
+    }
+
+    CPPUNIT_ASSERT_EQUAL(idle, cache.idleCount(EYE_CASCADE));
+}
+
+void CascadeCacheTest::testPreload() {
+    CascadeCache& cache = CascadeCache::instance();
+
+    cache.preload(EYE_CASCADE, 3);
+    CPPUNIT_ASSERT(cache.idleCount(EYE_CASCADE) >= 3);
+}
+
+void CascadeCacheTest::testMissingFile() {
+    CascadeLease lease;
+    CPPUNIT_ASSERT_THROW(lease.acquire("../__haarcascades/missing.xml"), GazeException);
+    CPPUNIT_ASSERT(!lease.isLoaded());
+}
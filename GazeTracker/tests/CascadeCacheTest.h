@@ -0,0 +1,38 @@
+/*
+ * File:   CascadeCacheTest.h
+ *
+ * Created on Oct 17, 2026, 9:12:40 PM
+ */
+
+#ifndef CASCADECACHETEST_H
+#define	CASCADECACHETEST_H
+
+#include <cppunit/extensions/HelperMacros.h>
+
+class CascadeCacheTest : public CPPUNIT_NS::TestFixture {
+    CPPUNIT_TEST_SUITE(CascadeCacheTest);
+
+    CPPUNIT_TEST(testReuse);
+    CPPUNIT_TEST(testConcurrentUsers);
+    CPPUNIT_TEST(testLease);
+    CPPUNIT_TEST(testPreload);
+    CPPUNIT_TEST(testMissingFile);
+
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+    CascadeCacheTest();
+    virtual ~CascadeCacheTest();
+    void setUp();
+    void tearDown();
+
+private:
+    void testReuse();
+    void testConcurrentUsers();
+    void testLease();
+    void testPreload();
+    void testMissingFile();
+};
+
+#endif	/* CASCADECACHETEST_H */
+
@@ -0,0 +1,94 @@
+/*
+ * File:   EyeRegionWorkerTest.cpp
+ *
+ * Created on Oct 17, 2026, 7:05:18 PM
+ */
+
+#include <unistd.h>
+
+#include <opencv2/core/core.hpp>
+
+#include "EyeRegionWorkerTest.h"
+#include "detection/eye/EyeRegionWorker.hpp"
+#include "video/SyntheticEyeSource.hpp"
+
+using namespace cv;
+
+CPPUNIT_TEST_SUITE_REGISTRATION(EyeRegionWorkerTest);
+
+/**
+ * waits until the worker is done with its frame
+ * @return false if it is still busy after 10 seconds
+ */
+static bool waitForWorker(EyeRegionWorker& worker) {
+    for (int i = 0; i < 10000 && worker.isBusy(); ++i)
+        usleep(1000);
+    return !worker.isBusy();
+}
+
+EyeRegionWorkerTest::EyeRegionWorkerTest() {
+}
+
+EyeRegionWorkerTest::~EyeRegionWorkerTest() {
+}
+
+void EyeRegionWorkerTest::setUp() {
+}
+
+void EyeRegionWorkerTest::tearDown() {
+}
+
+void EyeRegionWorkerTest::testNotFound() {
+    EyeRegionWorker worker;
+    SyntheticEyeSource source;
+    Mat frame;
+    Rect regions[NUM_OF_EYES];
+
+    CPPUNIT_ASSERT(worker.poll(regions) == EYE_SEARCH_IDLE);
+
+    // there is no face in the synthetic frames
+    CPPUNIT_ASSERT(source.nextGrayFrame(frame));
+    CPPUNIT_ASSERT(worker.search(frame, source.lastFrameInfo()));
+    CPPUNIT_ASSERT(waitForWorker(worker));
+    CPPUNIT_ASSERT(worker.poll(regions) == EYE_SEARCH_NOT_FOUND);
+
+    // the result is taken only once
+    CPPUNIT_ASSERT(worker.poll(regions) == EYE_SEARCH_IDLE);
+
+    // the worker takes the next frame
+    CPPUNIT_ASSERT(source.nextGrayFrame(frame));
+    CPPUNIT_ASSERT(worker.search(frame, source.lastFrameInfo(), true));
+    CPPUNIT_ASSERT(waitForWorker(worker));
+    CPPUNIT_ASSERT(worker.poll(regions) == EYE_SEARCH_NOT_FOUND);
+}
+
+void EyeRegionWorkerTest::testCancel() {
+    EyeRegionWorker worker;
+    SyntheticEyeSource source;
+    Mat frame;
+    Rect regions[NUM_OF_EYES];
+
+    CPPUNIT_ASSERT(source.nextGrayFrame(frame));
+    CPPUNIT_ASSERT(worker.search(frame, source.lastFrameInfo()));
+    worker.cancel();
+    CPPUNIT_ASSERT(worker.poll(regions) == EYE_SEARCH_IDLE);
+
+    // the result of the cancelled search is dropped
+    CPPUNIT_ASSERT(waitForWorker(worker));
+    CPPUNIT_ASSERT(worker.poll(regions) == EYE_SEARCH_IDLE);
+}
+
+void EyeRegionWorkerTest::testSynchronous() {
+    EyeRegionWorker worker;
+    worker.setSynchronous(true);
+    SyntheticEyeSource source;
+    Mat frame;
+    Rect regions[NUM_OF_EYES];
+
+    // the result is there as soon as search() returns
+    CPPUNIT_ASSERT(source.nextGrayFrame(frame));
+    CPPUNIT_ASSERT(worker.search(frame, source.lastFrameInfo()));
+    CPPUNIT_ASSERT(!worker.isBusy());
+    CPPUNIT_ASSERT(worker.poll(regions) == EYE_SEARCH_NOT_FOUND);
+    CPPUNIT_ASSERT(worker.poll(regions) == EYE_SEARCH_IDLE);
+}
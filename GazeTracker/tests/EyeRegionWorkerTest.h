@@ -0,0 +1,34 @@
+/*
+ * File:   EyeRegionWorkerTest.h
+ *
+ * Created on Oct 17, 2026, 7:05:18 PM
+ */
+
+#ifndef EYEREGIONWORKERTEST_H
+#define	EYEREGIONWORKERTEST_H
+
+#include <cppunit/extensions/HelperMacros.h>
+
+class EyeRegionWorkerTest : public CPPUNIT_NS::TestFixture {
+    CPPUNIT_TEST_SUITE(EyeRegionWorkerTest);
+
+    CPPUNIT_TEST(testNotFound);
+    CPPUNIT_TEST(testCancel);
+    CPPUNIT_TEST(testSynchronous);
+
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+    EyeRegionWorkerTest();
+    virtual ~EyeRegionWorkerTest();
+    void setUp();
+    void tearDown();
+
+private:
+    void testNotFound();
+    void testCancel();
+    void testSynchronous();
+};
+
+#endif	/* EYEREGIONWORKERTEST_H */
+
@@ -0,0 +1,120 @@
+/*
+ * File:   EyeTemplateTrackerTest.cpp
+ *
+ * Created on Oct 17, 2026, 8:26:09 PM
+ */
+
+#include <opencv2/core/core.hpp>
+#include <opencv2/imgproc/imgproc.hpp>
+
+#include "EyeTemplateTrackerTest.h"
+#include "detection/eye/EyeTemplateTracker.hpp"
+#include "video/SyntheticEyeSource.hpp"
+
+using namespace cv;
+
+CPPUNIT_TEST_SUITE_REGISTRATION(EyeTemplateTrackerTest);
+
+/// the eye region of the synthetic frames (the eye stays inside)
+static const Rect EYE_REGION(220, 140, 200, 200);
+static const Size TEMPLATE_SIZE(80, 80);
+/// the estimated glint center may be off by the scaling and the pupil
+/// moving relative to the glints
+static const float MAX_CENTER_ERROR = 6;
+
+static bool isNear(const Point2f& estimated, const Point2f& truth) {
+    Point2f error = estimated - truth;
+    return error.dot(error) <= MAX_CENTER_ERROR * MAX_CENTER_ERROR;
+}
+
+/**
+ * @return the ground truth glint center in the eye region
+ */
+static Point2f glintCenterIn(SyntheticEyeSource& source) {
+    EyeGroundTruth truth = source.groundTruth(source.lastFrameInfo().sequenceNumber);
+    return truth.glintCenter - Point2f(EYE_REGION.x, EYE_REGION.y);
+}
+
+EyeTemplateTrackerTest::EyeTemplateTrackerTest() {
+}
+
+EyeTemplateTrackerTest::~EyeTemplateTrackerTest() {
+}
+
+void EyeTemplateTrackerTest::setUp() {
+}
+
+void EyeTemplateTrackerTest::tearDown() {
+}
+
+void EyeTemplateTrackerTest::testNoTemplate() {
+    SyntheticEyeSource source;
+    EyeTemplateTracker tracker;
+    Mat frame;
+    CPPUNIT_ASSERT(source.nextGrayFrame(frame));
+
+    Point2f glintCenter;
+    CPPUNIT_ASSERT(!tracker.hasTemplate());
+    CPPUNIT_ASSERT(!tracker.relocate(frame(EYE_REGION), glintCenter));
+
+    tracker.update(frame(EYE_REGION), glintCenterIn(source), TEMPLATE_SIZE);
+    CPPUNIT_ASSERT(tracker.hasTemplate());
+    tracker.reset();
+    CPPUNIT_ASSERT(!tracker.hasTemplate());
+}
+
+void EyeTemplateTrackerTest::testFollowsEye() {
+    SyntheticEyeSource source;
+    EyeTemplateTracker tracker;
+    Mat frame;
+
+    for (int i = 0; i < 30; ++i) {
+        CPPUNIT_ASSERT(source.nextGrayFrame(frame));
+        Point2f truth = glintCenterIn(source);
+
+        if (i > 0) {
+            Point2f glintCenter;
+            CPPUNIT_ASSERT(tracker.relocate(frame(EYE_REGION), glintCenter));
+            CPPUNIT_ASSERT(isNear(glintCenter, truth));
+            CPPUNIT_ASSERT(tracker.lastCorrelation() > 0.7);
+        }
+
+        // the glints are found in every frame, the template follows
+        tracker.update(frame(EYE_REGION), truth, TEMPLATE_SIZE);
+    }
+}
+
+void EyeTemplateTrackerTest::testHiddenGlints() {
+    SyntheticEyeSource source;
+    EyeTemplateTracker tracker;
+    Mat frame;
+
+    CPPUNIT_ASSERT(source.nextGrayFrame(frame));
+    tracker.update(frame(EYE_REGION), glintCenterIn(source), TEMPLATE_SIZE);
+
+    // a reflection covers the glints of the next frame
+    CPPUNIT_ASSERT(source.nextGrayFrame(frame));
+    EyeGroundTruth truth = source.groundTruth(source.lastFrameInfo().sequenceNumber);
+    for (unsigned int g = 0; g < truth.glints.size(); ++g)
+        circle(frame, truth.glints.at(g), 6, Scalar(90), -1);
+
+    Point2f glintCenter;
+    CPPUNIT_ASSERT(tracker.relocate(frame(EYE_REGION), glintCenter));
+    CPPUNIT_ASSERT(isNear(glintCenter, glintCenterIn(source)));
+}
+
+void EyeTemplateTrackerTest::testNoEye() {
+    SyntheticEyeSource source;
+    EyeTemplateTracker tracker;
+    Mat frame;
+
+    CPPUNIT_ASSERT(source.nextGrayFrame(frame));
+    tracker.update(frame(EYE_REGION), glintCenterIn(source), TEMPLATE_SIZE);
+
+    Mat noise(EYE_REGION.size(), CV_8UC1);
+    randu(noise, Scalar(0), Scalar(255));
+
+    Point2f glintCenter;
+    CPPUNIT_ASSERT(!tracker.relocate(noise, glintCenter));
+    CPPUNIT_ASSERT(tracker.lastCorrelation() < 0.7);
+}
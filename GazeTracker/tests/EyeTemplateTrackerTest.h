@@ -0,0 +1,36 @@
+/*
+ * File:   EyeTemplateTrackerTest.h
+ *
+ * Created on Oct 17, 2026, 8:26:09 PM
+ */
+
+#ifndef EYETEMPLATETRACKERTEST_H
+#define	EYETEMPLATETRACKERTEST_H
+
+#include <cppunit/extensions/HelperMacros.h>
+
+class EyeTemplateTrackerTest : public CPPUNIT_NS::TestFixture {
+    CPPUNIT_TEST_SUITE(EyeTemplateTrackerTest);
+
+    CPPUNIT_TEST(testNoTemplate);
+    CPPUNIT_TEST(testFollowsEye);
+    CPPUNIT_TEST(testHiddenGlints);
+    CPPUNIT_TEST(testNoEye);
+
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+    EyeTemplateTrackerTest();
+    virtual ~EyeTemplateTrackerTest();
+    void setUp();
+    void tearDown();
+
+private:
+    void testNoTemplate();
+    void testFollowsEye();
+    void testHiddenGlints();
+    void testNoEye();
+};
+
+#endif	/* EYETEMPLATETRACKERTEST_H */
+
@@ -0,0 +1,97 @@
+/*
+ * File:   FrameResultTest.cpp
+ *
+ * Created on Oct 17, 2026, 3:21:40 PM
+ */
+
+#include <opencv2/core/core.hpp>
+
+#include "FrameResultTest.h"
+#include "detection/FrameResult.hpp"
+
+using namespace cv;
+
+CPPUNIT_TEST_SUITE_REGISTRATION(FrameResultTest);
+
+/**
+ * a black eye region at (100, 50) of the full frame with the glints at 
+ * (130, 70) and the pupil at (120, 80)
+ */
+static FrameResult measuredFrame() {
+    FrameResult frameResult;
+    frameResult.image = Mat::zeros(60, 80, CV_8UC1);
+    frameResult.region = Rect(100, 50, 80, 60);
+    frameResult.result = MEASURE_OK;
+    frameResult.glintCenter = Point2f(130, 70);
+    frameResult.pupilCenter = Point2f(120, 80);
+    frameResult.pupilRadius = 8;
+    return frameResult;
+}
+
+FrameResultTest::FrameResultTest() {
+}
+
+FrameResultTest::~FrameResultTest() {
+}
+
+void FrameResultTest::setUp() {
+}
+
+void FrameResultTest::tearDown() {
+}
+
+void FrameResultTest::testImageUntouched() {
+    FrameResult frameResult = measuredFrame();
+
+    Mat overlay = frameResult.renderOverlay();
+
+    CPPUNIT_ASSERT(countNonZero(overlay) > 0);
+    CPPUNIT_ASSERT_EQUAL(0, countNonZero(frameResult.image));
+}
+
+void FrameResultTest::testOverlay() {
+    FrameResult frameResult = measuredFrame();
+
+    Mat overlay = frameResult.renderOverlay();
+
+    // the centers are drawn in eye region coordinates
+    CPPUNIT_ASSERT_EQUAL(255, (int) overlay.at<uchar>(20, 30));
+    CPPUNIT_ASSERT_EQUAL(255, (int) overlay.at<uchar>(30, 20));
+    // the circle of the pupil
+    CPPUNIT_ASSERT_EQUAL(255, (int) overlay.at<uchar>(30, 28));
+    // far from both
+    CPPUNIT_ASSERT_EQUAL(0, (int) overlay.at<uchar>(55, 75));
+}
+
+void FrameResultTest::testFailedMeasure() {
+    FrameResult frameResult = measuredFrame();
+    frameResult.result = FINDPUPIL_FAILED;
+
+    Mat overlay = frameResult.renderOverlay();
+
+    // only the glints are drawn
+    CPPUNIT_ASSERT_EQUAL(255, (int) overlay.at<uchar>(20, 30));
+    CPPUNIT_ASSERT_EQUAL(0, (int) overlay.at<uchar>(30, 20));
+
+    frameResult.result = FINDGLINT_FAILED;
+    CPPUNIT_ASSERT_EQUAL(0, countNonZero(frameResult.renderOverlay()));
+}
+
+void FrameResultTest::testBinocularOverlay() {
+    FrameResult frameResult = measuredFrame();
+    frameResult.binocular = true;
+    frameResult.eyes[LEFT_EYE].result = MEASURE_OK;
+    frameResult.eyes[LEFT_EYE].glintCenter = Point2f(110, 60);
+    frameResult.eyes[LEFT_EYE].pupilCenter = Point2f(115, 65);
+    frameResult.eyes[LEFT_EYE].pupilRadius = 3;
+    frameResult.eyes[RIGHT_EYE].result = FINDPUPIL_FAILED;
+    frameResult.eyes[RIGHT_EYE].glintCenter = Point2f(160, 90);
+
+    Mat overlay = frameResult.renderOverlay();
+
+    // the eyes are drawn, not the single eye fields
+    CPPUNIT_ASSERT_EQUAL(255, (int) overlay.at<uchar>(10, 10));
+    CPPUNIT_ASSERT_EQUAL(255, (int) overlay.at<uchar>(15, 15));
+    CPPUNIT_ASSERT_EQUAL(255, (int) overlay.at<uchar>(40, 60));
+    CPPUNIT_ASSERT_EQUAL(0, (int) overlay.at<uchar>(20, 30));
+}
@@ -0,0 +1,35 @@
+/*
+ * File:   FrameResultTest.h
+ *
+ * Created on Oct 17, 2026, 3:21:40 PM
+ */
+
+#ifndef FRAMERESULTTEST_H
+#define	FRAMERESULTTEST_H
+
+#include <cppunit/extensions/HelperMacros.h>
+
+class FrameResultTest : public CPPUNIT_NS::TestFixture {
+    CPPUNIT_TEST_SUITE(FrameResultTest);
+
+    CPPUNIT_TEST(testImageUntouched);
+    CPPUNIT_TEST(testOverlay);
+    CPPUNIT_TEST(testFailedMeasure);
+    CPPUNIT_TEST(testBinocularOverlay);
+
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+    FrameResultTest();
+    virtual ~FrameResultTest();
+    void setUp();
+    void tearDown();
+
+private:
+    void testImageUntouched();
+    void testOverlay();
+    void testFailedMeasure();
+    void testBinocularOverlay();
+};
+
+#endif	/* FRAMERESULTTEST_H */
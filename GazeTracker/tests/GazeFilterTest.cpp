@@ -0,0 +1,163 @@
+/*
+ * File:   GazeFilterTest.cpp
+ *
+ * Created on Oct 17, 2026, 2:03:51 PM
+ */
+
+#include <cmath>
+
+#include <opencv2/core/core.hpp>
+
+#include "GazeFilterTest.h"
+#include "filter/GazeFilter.hpp"
+
+using namespace cv;
+
+CPPUNIT_TEST_SUITE_REGISTRATION(GazeFilterTest);
+
+// the time between two frames (30 fps)
+static const double PERIOD = 1.0 / 30;
+
+/**
+ * a fixation with some noise at start, then a saccade to end
+ */
+static Point2f fixationAndSaccade(int sample, const Point2f& start, const Point2f& end, RNG& rng) {
+    Point2f noise(rng.gaussian(0.5), rng.gaussian(0.5));
+    return (sample < 30 ? start : end) + noise;
+}
+
+GazeFilterTest::GazeFilterTest() {
+}
+
+GazeFilterTest::~GazeFilterTest() {
+}
+
+void GazeFilterTest::setUp() {
+}
+
+void GazeFilterTest::tearDown() {
+}
+
+void GazeFilterTest::testBoxFilter() {
+    BoxFilter box(4);
+
+    // the average of the samples so far, then of the last 4 samples
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(2, box.filter(Point2f(2, 0), 0).x, 1e-5);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(3, box.filter(Point2f(4, 0), 0).x, 1e-5);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(4, box.filter(Point2f(6, 0), 0).x, 1e-5);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(5, box.filter(Point2f(8, 0), 0).x, 1e-5);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(7, box.filter(Point2f(10, 0), 0).x, 1e-5);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(9, box.filter(Point2f(12, 0), 0).x, 1e-5);
+}
+
+void GazeFilterTest::testBoxFilterDrift() {
+    BoxFilter box(4);
+    RNG rng(42);
+
+    // large values leave rounding errors in a running sum
+    for (int i = 0; i < 100000; ++i)
+        box.filter(Point2f(rng.uniform(0.f, 100000.f), 0), 0);
+
+    Point2f filtered;
+    for (int i = 0; i < 4; ++i)
+        filtered = box.filter(Point2f(1.5, 0), 0);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(1.5, filtered.x, 1e-5);
+}
+
+void GazeFilterTest::testOneEuroFilter() {
+    OneEuroFilter oneEuro;
+    BoxFilter box;
+    RNG rng(42);
+
+    Point2f start(-10, 5);
+    Point2f end(15, -5);
+
+    double oneEuroJitter = 0;
+    double rawJitter = 0;
+    Point2f filtered;
+    Point2f lastFiltered;
+    Point2f boxed;
+    for (int i = 0; i < 33; ++i) {
+        Point2f measured = fixationAndSaccade(i, start, end, rng);
+        lastFiltered = filtered;
+        filtered = oneEuro.filter(measured, i * PERIOD);
+        boxed = box.filter(measured, i * PERIOD);
+
+        // the fixation is smoothed
+        if (i > 10 && i < 30) {
+            oneEuroJitter += norm(filtered - lastFiltered);
+            rawJitter += norm(measured - start);
+        }
+    }
+    CPPUNIT_ASSERT(oneEuroJitter < rawJitter / 2);
+
+    // three frames after the saccade the filter is closer to the end than
+    // the moving average
+    CPPUNIT_ASSERT(norm(filtered - end) < norm(boxed - end));
+    CPPUNIT_ASSERT(norm(filtered - end) < norm(end - start) / 4);
+}
+
+void GazeFilterTest::testKalmanGazeFilter() {
+    KalmanGazeFilter kalman;
+
+    // a smooth pursuit with constant velocity is followed without lag
+    Point2f velocity(60, -30);
+    Point2f filtered;
+    Point2f measured;
+    for (int i = 0; i < 60; ++i) {
+        measured = velocity * (i * PERIOD);
+        filtered = kalman.filter(measured, i * PERIOD);
+    }
+    CPPUNIT_ASSERT(norm(filtered - measured) < 0.5);
+
+    // dropped frames are a longer step in time
+    measured = velocity * (65 * PERIOD);
+    filtered = kalman.filter(measured, 65 * PERIOD);
+    CPPUNIT_ASSERT(norm(filtered - measured) < 0.5);
+}
+
+void GazeFilterTest::testHampelFilter() {
+    HampelFilter hampel(7, 3);
+    RNG rng(7);
+
+    Point2f fixation(3, 4);
+    for (int i = 0; i < 10; ++i)
+        hampel.filter(fixation + Point2f(rng.gaussian(0.5), rng.gaussian(0.5)), i * PERIOD);
+
+    // a single wrong pupil is replaced with the median
+    Point2f filtered = hampel.filter(Point2f(30, -20), 10 * PERIOD);
+    CPPUNIT_ASSERT(norm(filtered - fixation) < 2);
+
+    // a saccade is passed on as soon as it is the majority of the window
+    Point2f target(-12, 9);
+    for (int i = 11; i < 16; ++i)
+        filtered = hampel.filter(target, i * PERIOD);
+    CPPUNIT_ASSERT(norm(filtered - target) < 1e-5);
+
+    // the next filter gets the samples without the outliers
+    BoxFilter box(1);
+    HampelFilter chained(7, 3, &box);
+    for (int i = 0; i < 10; ++i)
+        chained.filter(fixation + Point2f(rng.gaussian(0.5), rng.gaussian(0.5)), i * PERIOD);
+    filtered = chained.filter(Point2f(30, -20), 10 * PERIOD);
+    CPPUNIT_ASSERT(norm(filtered - fixation) < 2);
+}
+
+void GazeFilterTest::testReset() {
+    OneEuroFilter oneEuro;
+    KalmanGazeFilter kalman;
+    BoxFilter box;
+    HampelFilter hampel;
+    GazeFilter *filters[] = {&oneEuro, &kalman, &box, &hampel};
+
+    for (unsigned int f = 0; f < 4; ++f) {
+        for (int i = 0; i < 10; ++i)
+            filters[f]->filter(Point2f(1, 1), i * PERIOD);
+
+        // after a reset the history is gone
+        filters[f]->reset();
+        Point2f filtered = filters[f]->filter(Point2f(20, -20), 10 * PERIOD);
+        CPPUNIT_ASSERT(norm(filtered - Point2f(20, -20)) < 1e-5);
+    }
+}
+
@@ -0,0 +1,40 @@
+/*
+ * File:   GazeFilterTest.h
+ *
+ * Created on Oct 17, 2026, 2:03:51 PM
+ */
+
+#ifndef GAZEFILTERTEST_H
+#define	GAZEFILTERTEST_H
+
+#include <cppunit/extensions/HelperMacros.h>
+
+class GazeFilterTest : public CPPUNIT_NS::TestFixture {
+    CPPUNIT_TEST_SUITE(GazeFilterTest);
+
+    CPPUNIT_TEST(testBoxFilter);
+    CPPUNIT_TEST(testBoxFilterDrift);
+    CPPUNIT_TEST(testOneEuroFilter);
+    CPPUNIT_TEST(testKalmanGazeFilter);
+    CPPUNIT_TEST(testHampelFilter);
+    CPPUNIT_TEST(testReset);
+
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+    GazeFilterTest();
+    virtual ~GazeFilterTest();
+    void setUp();
+    void tearDown();
+
+private:
+    void testBoxFilter();
+    void testBoxFilterDrift();
+    void testOneEuroFilter();
+    void testKalmanGazeFilter();
+    void testHampelFilter();
+    void testReset();
+};
+
+#endif	/* GAZEFILTERTEST_H */
+
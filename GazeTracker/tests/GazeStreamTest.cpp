@@ -0,0 +1,194 @@
+/*
+ * File:   GazeStreamTest.cpp
+ *
+ * Created on Oct 17, 2026, 5:12:33 PM
+ */
+
+#include <cstring>
+#include <sstream>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+
+#include "GazeStreamTest.h"
+#include "service/GazeStreamReader.hpp"
+#include "service/GazeStreamWriter.hpp"
+#include "exception/GazeExceptions.hpp"
+
+using namespace std;
+using namespace cv;
+
+CPPUNIT_TEST_SUITE_REGISTRATION(GazeStreamTest);
+
+/// a stream of its own, a running gaze service is not disturbed
+static string streamName() {
+    ostringstream name;
+    name << "/gazelib-test-" << getpid();
+    return name.str();
+}
+
+static FrameResult frame(unsigned long sequenceNumber) {
+    FrameResult frameResult;
+    frameResult.result = MEASURE_OK;
+    frameResult.gazeVector = Point2f(sequenceNumber, -1.f * sequenceNumber);
+    frameResult.confidence = 0.5f;
+    frameResult.pupilCenter = Point2f(320, 240);
+    frameResult.pupilRadius = 12;
+    frameResult.frameInfo.sequenceNumber = sequenceNumber;
+    frameResult.frameInfo.captureTick = getTickCount();
+    return frameResult;
+}
+
+GazeStreamTest::GazeStreamTest() {
+}
+
+GazeStreamTest::~GazeStreamTest() {
+}
+
+void GazeStreamTest::setUp() {
+}
+
+void GazeStreamTest::tearDown() {
+}
+
+void GazeStreamTest::testPublishAndRead() {
+    GazeStreamWriter writer(streamName(), 16);
+    // a reader starts with the samples published after it has opened the stream
+    writer.publish(frame(1));
+    GazeStreamReader reader(streamName());
+
+    GazeStreamSample sample;
+    CPPUNIT_ASSERT(!reader.next(sample));
+
+    for (unsigned long i = 2; i <= 5; ++i)
+        writer.publish(frame(i));
+
+    for (unsigned long i = 2; i <= 5; ++i) {
+        CPPUNIT_ASSERT(reader.next(sample));
+        CPPUNIT_ASSERT_EQUAL((uint64_t) i, sample.sequenceNumber);
+        CPPUNIT_ASSERT_EQUAL((float) i, sample.gazeX);
+        CPPUNIT_ASSERT_EQUAL(-1.f * i, sample.gazeY);
+        CPPUNIT_ASSERT_EQUAL(0, sample.result);
+        CPPUNIT_ASSERT_EQUAL(12.f, sample.pupilRadius);
+    }
+    CPPUNIT_ASSERT(!reader.next(sample));
+    CPPUNIT_ASSERT_EQUAL(0ul, reader.missedSamples());
+
+    // the capture time is on the clock of the reader
+    int64_t age = GazeStreamReader::nowMicros() - sample.captureMicros;
+    CPPUNIT_ASSERT(age >= 0 && age < 1000000);
+}
+
+void GazeStreamTest::testSeveralReaders() {
+    GazeStreamWriter writer(streamName(), 16);
+    GazeStreamReader first(streamName());
+    GazeStreamReader second(streamName());
+
+    writer.publish(frame(1));
+    writer.publish(frame(2));
+
+    GazeStreamSample sample;
+    CPPUNIT_ASSERT(first.next(sample));
+    CPPUNIT_ASSERT(first.next(sample));
+    CPPUNIT_ASSERT_EQUAL((uint64_t) 2, sample.sequenceNumber);
+
+    // every reader has its own position
+    CPPUNIT_ASSERT(second.next(sample));
+    CPPUNIT_ASSERT_EQUAL((uint64_t) 1, sample.sequenceNumber);
+}
+
+void GazeStreamTest::testSlowReader() {
+    GazeStreamWriter writer(streamName(), 8);
+    GazeStreamReader reader(streamName());
+
+    for (unsigned long i = 1; i <= 20; ++i)
+        writer.publish(frame(i));
+
+    // the oldest 12 samples have been overwritten
+    GazeStreamSample sample;
+    CPPUNIT_ASSERT(reader.next(sample));
+    CPPUNIT_ASSERT_EQUAL((uint64_t) 13, sample.sequenceNumber);
+    CPPUNIT_ASSERT_EQUAL(12ul, reader.missedSamples());
+
+    unsigned int count = 1;
+    while (reader.next(sample))
+        ++count;
+    CPPUNIT_ASSERT_EQUAL(8u, count);
+    CPPUNIT_ASSERT_EQUAL((uint64_t) 20, sample.sequenceNumber);
+}
+
+void GazeStreamTest::testLatest() {
+    GazeStreamWriter writer(streamName(), 8);
+    GazeStreamReader reader(streamName());
+
+    GazeStreamSample sample;
+    CPPUNIT_ASSERT(!reader.latest(sample));
+
+    for (unsigned long i = 1; i <= 5; ++i)
+        writer.publish(frame(i));
+
+    CPPUNIT_ASSERT(reader.latest(sample));
+    CPPUNIT_ASSERT_EQUAL((uint64_t) 5, sample.sequenceNumber);
+    CPPUNIT_ASSERT(!reader.next(sample));
+    CPPUNIT_ASSERT_EQUAL(0ul, reader.missedSamples());
+}
+
+void GazeStreamTest::testStatus() {
+    CPPUNIT_ASSERT_THROW(GazeStreamReader reader(streamName()), GazeException);
+
+    {
+        GazeStreamWriter writer(streamName(), 8);
+        GazeStreamReader reader(streamName());
+        CPPUNIT_ASSERT_EQUAL(STREAM_STARTING, reader.status());
+
+        writer.setStatus(STREAM_SEARCHING);
+        CPPUNIT_ASSERT_EQUAL(STREAM_SEARCHING, reader.status());
+
+        writer.publish(frame(1));
+        writer.setDroppedFrames(3);
+        CPPUNIT_ASSERT_EQUAL(STREAM_TRACKING, reader.status());
+        CPPUNIT_ASSERT_EQUAL(3ul, reader.droppedFrames());
+        CPPUNIT_ASSERT(reader.heartbeatAgeMicros() < 1000000);
+    }
+
+    // the writer has removed the stream
+    CPPUNIT_ASSERT_THROW(GazeStreamReader reader(streamName()), GazeException);
+}
+
+void GazeStreamTest::testLiveWriterKeepsStream() {
+    GazeStreamWriter writer(streamName(), 8);
+    GazeStreamReader reader(streamName());
+
+    // the first writer holds the lock of the stream
+    CPPUNIT_ASSERT_THROW(GazeStreamWriter second(streamName(), 8), GazeException);
+
+    writer.publish(frame(1));
+    GazeStreamSample sample;
+    CPPUNIT_ASSERT(reader.next(sample));
+    CPPUNIT_ASSERT_EQUAL((uint64_t) 1, sample.sequenceNumber);
+}
+
+void GazeStreamTest::testStaleStreamReplaced() {
+    // a stream left behind by a crashed writer: nobody holds its lock, the
+    // process id in its header does not matter
+    int fd = shm_open(streamName().c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+    CPPUNIT_ASSERT(fd >= 0);
+    size_t size = sizeof (GazeStreamHeader) + sizeof (GazeStreamSample);
+    CPPUNIT_ASSERT(ftruncate(fd, size) == 0);
+    void *addr = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    CPPUNIT_ASSERT(addr != MAP_FAILED);
+
+    GazeStreamHeader *stale = static_cast<GazeStreamHeader*> (addr);
+    stale->version = GAZE_STREAM_VERSION;
+    stale->capacity = 1;
+    stale->writerPid = getpid();
+    stale->status = STREAM_TRACKING;
+    strncpy(stale->magic, GAZE_STREAM_MAGIC, sizeof (stale->magic));
+    munmap(addr, size);
+
+    GazeStreamWriter writer(streamName(), 8);
+    GazeStreamReader reader(streamName());
+    CPPUNIT_ASSERT_EQUAL(STREAM_STARTING, reader.status());
+}
@@ -0,0 +1,41 @@
+/*
+ * File:   GazeStreamTest.h
+ *
+ * Created on Oct 17, 2026, 5:12:33 PM
+ */
+
+#ifndef GAZESTREAMTEST_H
+#define	GAZESTREAMTEST_H
+
+#include <cppunit/extensions/HelperMacros.h>
+
+class GazeStreamTest : public CPPUNIT_NS::TestFixture {
+    CPPUNIT_TEST_SUITE(GazeStreamTest);
+
+    CPPUNIT_TEST(testPublishAndRead);
+    CPPUNIT_TEST(testSeveralReaders);
+    CPPUNIT_TEST(testSlowReader);
+    CPPUNIT_TEST(testLatest);
+    CPPUNIT_TEST(testStatus);
+    CPPUNIT_TEST(testLiveWriterKeepsStream);
+    CPPUNIT_TEST(testStaleStreamReplaced);
+
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+    GazeStreamTest();
+    virtual ~GazeStreamTest();
+    void setUp();
+    void tearDown();
+
+private:
+    void testPublishAndRead();
+    void testSeveralReaders();
+    void testSlowReader();
+    void testLatest();
+    void testStatus();
+    void testLiveWriterKeepsStream();
+    void testStaleStreamReplaced();
+};
+
+#endif	/* GAZESTREAMTEST_H */
@@ -0,0 +1,91 @@
+/*
+ * File:   GlintPatternLocatorTest.cpp
+ *
+ * Created on Oct 17, 2026, 7:48:31 PM
+ */
+
+#include <vector>
+
+#include <opencv2/core/core.hpp>
+
+#include "GlintPatternLocatorTest.h"
+#include "detection/eye/GlintPatternLocator.hpp"
+#include "video/SyntheticEyeSource.hpp"
+
+using namespace std;
+using namespace cv;
+
+CPPUNIT_TEST_SUITE_REGISTRATION(GlintPatternLocatorTest);
+
+/// the center of the proposed eye may be off by the scaling (3 pixels of
+/// the small frame)
+static const float MAX_CENTER_ERROR = 6;
+
+static bool isCenteredAt(const Rect& eye, const Point2f& glintCenter) {
+    Point2f center(eye.x + eye.width / 2.f, eye.y + eye.height / 2.f);
+    Point2f error = center - glintCenter;
+    return eye.contains(Point(cvRound(glintCenter.x), cvRound(glintCenter.y)))
+            && error.dot(error) <= MAX_CENTER_ERROR * MAX_CENTER_ERROR;
+}
+
+GlintPatternLocatorTest::GlintPatternLocatorTest() {
+}
+
+GlintPatternLocatorTest::~GlintPatternLocatorTest() {
+}
+
+void GlintPatternLocatorTest::setUp() {
+}
+
+void GlintPatternLocatorTest::tearDown() {
+}
+
+void GlintPatternLocatorTest::testSyntheticEye() {
+    SyntheticEyeSource source;
+    GlintPatternLocator locator;
+
+    Mat frame;
+    vector<Rect> eyes;
+    for (int i = 0; i < 30; ++i) {
+        CPPUNIT_ASSERT(source.nextGrayFrame(frame));
+        EyeGroundTruth truth = source.groundTruth(source.lastFrameInfo().sequenceNumber);
+
+        CPPUNIT_ASSERT_EQUAL(1, locator.locate(frame, eyes));
+        CPPUNIT_ASSERT(isCenteredAt(eyes.at(0), truth.glintCenter));
+    }
+}
+
+void GlintPatternLocatorTest::testTwoEyes() {
+    SyntheticEyeSource source;
+    GlintPatternLocator locator;
+
+    // two eyes side by side, the right one a few frames later
+    Mat left, right;
+    CPPUNIT_ASSERT(source.nextGrayFrame(left));
+    EyeGroundTruth leftTruth = source.groundTruth(source.lastFrameInfo().sequenceNumber);
+    for (int i = 0; i < 20; ++i)
+        CPPUNIT_ASSERT(source.nextGrayFrame(right));
+    EyeGroundTruth rightTruth = source.groundTruth(source.lastFrameInfo().sequenceNumber);
+
+    Mat frame(left.rows, left.cols * 2, CV_8UC1);
+    left.copyTo(frame(Rect(0, 0, left.cols, left.rows)));
+    right.copyTo(frame(Rect(left.cols, 0, right.cols, right.rows)));
+    rightTruth.glintCenter.x += left.cols;
+
+    vector<Rect> eyes;
+    CPPUNIT_ASSERT_EQUAL(2, locator.locate(frame, eyes, 2));
+    CPPUNIT_ASSERT(isCenteredAt(eyes.at(0), leftTruth.glintCenter));
+    CPPUNIT_ASSERT(isCenteredAt(eyes.at(1), rightTruth.glintCenter));
+
+    // only one eye is asked for
+    CPPUNIT_ASSERT_EQUAL(1, locator.locate(frame, eyes, 1));
+}
+
+void GlintPatternLocatorTest::testNoGlints() {
+    GlintPatternLocator locator;
+    Mat frame(480, 640, CV_8UC1, Scalar(120));
+
+    vector<Rect> eyes;
+    CPPUNIT_ASSERT_EQUAL(0, locator.locate(frame, eyes, 2));
+    CPPUNIT_ASSERT(eyes.empty());
+}
@@ -0,0 +1,34 @@
+/*
+ * File:   GlintPatternLocatorTest.h
+ *
+ * Created on Oct 17, 2026, 7:48:31 PM
+ */
+
+#ifndef GLINTPATTERNLOCATORTEST_H
+#define	GLINTPATTERNLOCATORTEST_H
+
+#include <cppunit/extensions/HelperMacros.h>
+
+class GlintPatternLocatorTest : public CPPUNIT_NS::TestFixture {
+    CPPUNIT_TEST_SUITE(GlintPatternLocatorTest);
+
+    CPPUNIT_TEST(testSyntheticEye);
+    CPPUNIT_TEST(testTwoEyes);
+    CPPUNIT_TEST(testNoGlints);
+
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+    GlintPatternLocatorTest();
+    virtual ~GlintPatternLocatorTest();
+    void setUp();
+    void tearDown();
+
+private:
+    void testSyntheticEye();
+    void testTwoEyes();
+    void testNoGlints();
+};
+
+#endif	/* GLINTPATTERNLOCATORTEST_H */
+
@@ -0,0 +1,187 @@
+/*
+ * File:   LatencyTest.cpp
+ *
+ * Created on Oct 17, 2026, 2:47:09 PM
+ */
+
+#include <unistd.h>
+
+#include "LatencyTest.h"
+#include "utils/latency.hpp"
+#include "utils/threads.hpp"
+
+CPPUNIT_TEST_SUITE_REGISTRATION(LatencyTest);
+
+/**
+ * records the values 1..numOfValues
+ */
+class Recorder : public Thread {
+private:
+    LatencyHistogram& histogram;
+    int numOfValues;
+
+protected:
+
+    void run() {
+        for (int i = 1; i <= numOfValues; ++i)
+            histogram.record(i);
+    }
+
+public:
+
+    Recorder(LatencyHistogram& histogram, int numOfValues) :
+    histogram(histogram), numOfValues(numOfValues) {
+    }
+
+    ~Recorder() {
+        join();
+    }
+};
+
+LatencyTest::LatencyTest() {
+}
+
+LatencyTest::~LatencyTest() {
+}
+
+void LatencyTest::setUp() {
+    StageTimings::setEnabled(true);
+    StageTimings::reset();
+}
+
+void LatencyTest::tearDown() {
+    StageTimings::setEnabled(true);
+}
+
+void LatencyTest::testSmallValues() {
+    LatencyHistogram histogram;
+    CPPUNIT_ASSERT_EQUAL((uint64) 0, histogram.count());
+    CPPUNIT_ASSERT_EQUAL((uint64) 0, histogram.percentile(50));
+
+    // values below 32 microseconds are kept exactly
+    for (uint64 i = 0; i < 32; ++i) {
+        LatencyHistogram single;
+        single.record(i);
+        CPPUNIT_ASSERT_EQUAL(i, single.percentile(100));
+    }
+}
+
+void LatencyTest::testRelativeError() {
+    uint64 values[] = {100, 999, 4711, 65536, 1000000, 123456789};
+
+    for (unsigned int i = 0; i < sizeof (values) / sizeof (values[0]); ++i) {
+        LatencyHistogram histogram;
+        // the maximum is exact, so record something bigger as well
+        histogram.record(values[i]);
+        histogram.record(values[i] * 4);
+
+        double percentile = histogram.percentile(50);
+        CPPUNIT_ASSERT(percentile >= values[i]);
+        CPPUNIT_ASSERT((percentile - values[i]) / values[i] < 1.0 / LatencyHistogram::SUB_BUCKETS);
+        CPPUNIT_ASSERT_EQUAL(values[i] * 4, histogram.max());
+    }
+}
+
+void LatencyTest::testPercentile() {
+    LatencyHistogram histogram;
+    for (uint64 i = 1; i <= 1000; ++i)
+        histogram.record(i);
+
+    CPPUNIT_ASSERT_EQUAL((uint64) 1000, histogram.count());
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(500.5, histogram.mean(), 1e-9);
+    CPPUNIT_ASSERT_EQUAL((uint64) 1000, histogram.max());
+
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(500, histogram.percentile(50), 500 / LatencyHistogram::SUB_BUCKETS);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(900, histogram.percentile(90), 900 / LatencyHistogram::SUB_BUCKETS);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(990, histogram.percentile(99), 990 / LatencyHistogram::SUB_BUCKETS);
+    CPPUNIT_ASSERT_EQUAL((uint64) 1000, histogram.percentile(100));
+
+    histogram.reset();
+    CPPUNIT_ASSERT_EQUAL((uint64) 0, histogram.count());
+    CPPUNIT_ASSERT_EQUAL((uint64) 0, histogram.max());
+}
+
+void LatencyTest::testConcurrentRecord() {
+    LatencyHistogram histogram;
+    const int numOfThreads = 4;
+    const int numOfValues = 20000;
+
+    {
+        Recorder *recorders[numOfThreads];
+        for (int i = 0; i < numOfThreads; ++i)
+            recorders[i] = new Recorder(histogram, numOfValues);
+        for (int i = 0; i < numOfThreads; ++i)
+            recorders[i]->start();
+        for (int i = 0; i < numOfThreads; ++i)
+            delete recorders[i];
+    }
+
+    // no sample has been lost
+    CPPUNIT_ASSERT_EQUAL((uint64) numOfThreads * numOfValues, histogram.count());
+    CPPUNIT_ASSERT_DOUBLES_EQUAL((numOfValues + 1) / 2.0, histogram.mean(), 1e-9);
+    CPPUNIT_ASSERT_EQUAL((uint64) numOfValues, histogram.max());
+}
+
+void LatencyTest::testScopedTimer() {
+    {
+        ScopedTimer timer(STAGE_CALLBACK);
+        usleep(2000);
+    }
+
+    LatencyHistogram& callback = StageTimings::histogram(STAGE_CALLBACK);
+    CPPUNIT_ASSERT_EQUAL((uint64) 1, callback.count());
+    CPPUNIT_ASSERT(callback.max() >= 2000);
+
+    // stop() records once
+    {
+        ScopedTimer timer(STAGE_CALLBACK);
+        timer.stop();
+    }
+    CPPUNIT_ASSERT_EQUAL((uint64) 2, callback.count());
+
+    // nothing is recorded while the timing is off
+    StageTimings::setEnabled(false);
+    {
+        ScopedTimer timer(STAGE_CALLBACK);
+    }
+    CPPUNIT_ASSERT_EQUAL((uint64) 2, callback.count());
+    CPPUNIT_ASSERT_EQUAL((uint64) 0, StageTimings::histogram(STAGE_CROP).count());
+}
+
+void LatencyTest::testFrameTimingScope() {
+    FrameTimings outer;
+    FrameTimings inner;
+    {
+        FrameTimingScope outerScope(outer);
+        {
+            ScopedTimer timer(STAGE_CROP);
+            usleep(1000);
+        }
+        {
+            // the inner scope takes the durations until it ends
+            FrameTimingScope innerScope(inner);
+            ScopedTimer timer(STAGE_FIND_GLINTS);
+            usleep(1000);
+        }
+        ScopedTimer timer(STAGE_CROP);
+        usleep(1000);
+    }
+
+    CPPUNIT_ASSERT(outer.micros[STAGE_CROP] >= 2000);
+    CPPUNIT_ASSERT_EQUAL((uint64) 0, outer.micros[STAGE_FIND_GLINTS]);
+    CPPUNIT_ASSERT(inner.micros[STAGE_FIND_GLINTS] >= 1000);
+    CPPUNIT_ASSERT_EQUAL((uint64) 0, inner.micros[STAGE_CROP]);
+
+    // the process wide histograms get the durations too
+    CPPUNIT_ASSERT_EQUAL((uint64) 2, StageTimings::histogram(STAGE_CROP).count());
+
+    // no scope, nothing is collected
+    FrameTimings before = outer;
+    {
+        ScopedTimer timer(STAGE_CROP);
+    }
+    CPPUNIT_ASSERT_EQUAL(before.micros[STAGE_CROP], outer.micros[STAGE_CROP]);
+
+    outer += inner;
+    CPPUNIT_ASSERT_EQUAL(inner.micros[STAGE_FIND_GLINTS], outer.micros[STAGE_FIND_GLINTS]);
+}
@@ -0,0 +1,40 @@
+/*
+ * File:   LatencyTest.h
+ *
+ * Created on Oct 17, 2026, 2:47:09 PM
+ */
+
+#ifndef LATENCYTEST_H
+#define	LATENCYTEST_H
+
+#include <cppunit/extensions/HelperMacros.h>
+
+class LatencyTest : public CPPUNIT_NS::TestFixture {
+    CPPUNIT_TEST_SUITE(LatencyTest);
+
+    CPPUNIT_TEST(testSmallValues);
+    CPPUNIT_TEST(testRelativeError);
+    CPPUNIT_TEST(testPercentile);
+    CPPUNIT_TEST(testConcurrentRecord);
+    CPPUNIT_TEST(testScopedTimer);
+    CPPUNIT_TEST(testFrameTimingScope);
+
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+    LatencyTest();
+    virtual ~LatencyTest();
+    void setUp();
+    void tearDown();
+
+private:
+    void testSmallValues();
+    void testRelativeError();
+    void testPercentile();
+    void testConcurrentRecord();
+    void testScopedTimer();
+    void testFrameTimingScope();
+};
+
+#endif	/* LATENCYTEST_H */
+
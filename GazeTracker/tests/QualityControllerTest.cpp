@@ -0,0 +1,120 @@
+/*
+ * File:   QualityControllerTest.cpp
+ *
+ * Created on Oct 17, 2026, 6:12:40 PM
+ */
+
+#include "QualityControllerTest.h"
+#include "detection/QualityController.hpp"
+#include "exception/GazeExceptions.hpp"
+
+CPPUNIT_TEST_SUITE_REGISTRATION(QualityControllerTest);
+
+// 30 frames per second
+static const double FRAME_PERIOD = 1000. / 30;
+static const double FRAME_PERIOD_MICROS = FRAME_PERIOD * 1000;
+
+/**
+ * simulates a pupil search whose processing time shrinks with the quality
+ * @param fullQualityMicros the processing time with the full quality
+ * @return the number of changes
+ */
+static int run(QualityController& controller, double fullQualityMicros, int frames) {
+    int changes = 0;
+    for (int i = 0; i < frames; ++i) {
+        if (controller.update(fullQualityMicros * controller.qualityPercent() / 100))
+            ++changes;
+    }
+    return changes;
+}
+
+QualityControllerTest::QualityControllerTest() {
+}
+
+QualityControllerTest::~QualityControllerTest() {
+}
+
+void QualityControllerTest::setUp() {
+}
+
+void QualityControllerTest::tearDown() {
+}
+
+void QualityControllerTest::testFullQualityWithHeadroom() {
+    QualityController controller(FRAME_PERIOD);
+
+    CPPUNIT_ASSERT_EQUAL(0, run(controller, FRAME_PERIOD_MICROS / 2, 100));
+    CPPUNIT_ASSERT_EQUAL(100, controller.qualityPercent());
+}
+
+void QualityControllerTest::testShedsUnderLoad() {
+    QualityController controller(FRAME_PERIOD);
+
+    // twice as slow as the camera: the quality drops to about the half at
+    // once and then settles below the target
+    run(controller, 2 * FRAME_PERIOD_MICROS, 100);
+    CPPUNIT_ASSERT(controller.qualityPercent() <= 50);
+    CPPUNIT_ASSERT(controller.qualityPercent() >= 30);
+    CPPUNIT_ASSERT(controller.averageProcessingMicros() <= FRAME_PERIOD_MICROS);
+
+    // the quality does not oscillate
+    int quality = controller.qualityPercent();
+    CPPUNIT_ASSERT_EQUAL(0, run(controller, 2 * FRAME_PERIOD_MICROS, 100));
+    CPPUNIT_ASSERT_EQUAL(quality, controller.qualityPercent());
+}
+
+void QualityControllerTest::testMinimumQuality() {
+    QualityController controller(FRAME_PERIOD, 40);
+
+    run(controller, 10 * FRAME_PERIOD_MICROS, 100);
+    CPPUNIT_ASSERT_EQUAL(40, controller.qualityPercent());
+}
+
+void QualityControllerTest::testRecovers() {
+    QualityController controller(FRAME_PERIOD);
+    run(controller, 3 * FRAME_PERIOD_MICROS, 100);
+    CPPUNIT_ASSERT(controller.qualityPercent() < 100);
+
+    // the load is gone, the quality returns step by step
+    CPPUNIT_ASSERT(run(controller, FRAME_PERIOD_MICROS / 2, 1000) > 1);
+    CPPUNIT_ASSERT_EQUAL(100, controller.qualityPercent());
+
+    controller.update(10 * FRAME_PERIOD_MICROS);
+    controller.reset();
+    CPPUNIT_ASSERT_EQUAL(100, controller.qualityPercent());
+}
+
+void QualityControllerTest::testApply() {
+    QualityController controller(FRAME_PERIOD);
+    TrackerConfig config;
+    config.starburstRays = 20;
+    config.starburstIterations = 10;
+    config.ransacIterations = 400;
+
+    TrackerConfig scaled = controller.apply(config);
+    CPPUNIT_ASSERT_EQUAL(20u, scaled.starburstRays);
+    CPPUNIT_ASSERT_EQUAL(10u, scaled.starburstIterations);
+    CPPUNIT_ASSERT_EQUAL(400u, scaled.ransacIterations);
+
+    run(controller, 2 * FRAME_PERIOD_MICROS, 10);
+    CPPUNIT_ASSERT_EQUAL(50, controller.qualityPercent());
+
+    scaled = controller.apply(config);
+    CPPUNIT_ASSERT_EQUAL(10u, scaled.starburstRays);
+    CPPUNIT_ASSERT_EQUAL(5u, scaled.starburstIterations);
+    CPPUNIT_ASSERT_EQUAL(200u, scaled.ransacIterations);
+    // the other values are kept
+    CPPUNIT_ASSERT_EQUAL(config.glintThreshold, scaled.glintThreshold);
+
+    // the pupil search keeps a few rays
+    run(controller, 100 * FRAME_PERIOD_MICROS, 100);
+    scaled = controller.apply(config);
+    CPPUNIT_ASSERT_EQUAL(8u, scaled.starburstRays);
+    CPPUNIT_ASSERT(scaled.ransacIterations >= 50);
+}
+
+void QualityControllerTest::testWrongArguments() {
+    CPPUNIT_ASSERT_THROW(QualityController(0), WrongArgumentException);
+    CPPUNIT_ASSERT_THROW(QualityController(FRAME_PERIOD, 0), WrongArgumentException);
+    CPPUNIT_ASSERT_THROW(QualityController(FRAME_PERIOD, 101), WrongArgumentException);
+}
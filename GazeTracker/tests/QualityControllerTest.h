@@ -0,0 +1,40 @@
+/*
+ * File:   QualityControllerTest.h
+ *
+ * Created on Oct 17, 2026, 6:12:40 PM
+ */
+
+#ifndef QUALITYCONTROLLERTEST_H
+#define	QUALITYCONTROLLERTEST_H
+
+#include <cppunit/extensions/HelperMacros.h>
+
+class QualityControllerTest : public CPPUNIT_NS::TestFixture {
+    CPPUNIT_TEST_SUITE(QualityControllerTest);
+
+    CPPUNIT_TEST(testFullQualityWithHeadroom);
+    CPPUNIT_TEST(testShedsUnderLoad);
+    CPPUNIT_TEST(testMinimumQuality);
+    CPPUNIT_TEST(testRecovers);
+    CPPUNIT_TEST(testApply);
+    CPPUNIT_TEST(testWrongArguments);
+
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+    QualityControllerTest();
+    virtual ~QualityControllerTest();
+    void setUp();
+    void tearDown();
+
+private:
+    void testFullQualityWithHeadroom();
+    void testShedsUnderLoad();
+    void testMinimumQuality();
+    void testRecovers();
+    void testApply();
+    void testWrongArguments();
+};
+
+#endif	/* QUALITYCONTROLLERTEST_H */
+
@@ -0,0 +1,135 @@
+/*
+ * File:   RawFrameTest.cpp
+ *
+ * Created on Oct 17, 2026, 10:12:31 AM
+ */
+
+#include <cstdio>
+#include <fstream>
+#include <opencv2/core/core.hpp>
+
+#include "RawFrameTest.h"
+#include "video/RawFrameRecorder.hpp"
+#include "video/MmapFrameSource.hpp"
+#include "exception/GazeExceptions.hpp"
+
+using namespace cv;
+using namespace std;
+
+CPPUNIT_TEST_SUITE_REGISTRATION(RawFrameTest);
+
+/**
+ * creates a frame whose pixels depend on the frame number
+ */
+static Mat testFrame(int number) {
+    Mat frame(48, 64, CV_8UC1);
+    for (int row = 0; row < frame.rows; ++row)
+        for (int col = 0; col < frame.cols; ++col)
+            frame.at<uchar>(row, col) = (row + col + number * 7) % 256;
+    return frame;
+}
+
+static void record(string path, int numOfFrames) {
+    RawFrameRecorder recorder(path);
+    for (int i = 0; i < numOfFrames; ++i) {
+        FrameInfo info;
+        info.captureTick = i * getTickFrequency() / 30;
+        // pretend that every third frame has been dropped
+        info.sequenceNumber = i + 1 + i / 2;
+        recorder.write(testFrame(i), info);
+    }
+    recorder.close();
+}
+
+RawFrameTest::RawFrameTest() {
+}
+
+RawFrameTest::~RawFrameTest() {
+}
+
+void RawFrameTest::setUp() {
+    path = "/tmp/gazelib_rawframetest.raw";
+}
+
+void RawFrameTest::tearDown() {
+    remove(path.c_str());
+}
+
+void RawFrameTest::testRecordAndReplay() {
+    record(path, 5);
+
+    MmapFrameSource source(path);
+    CPPUNIT_ASSERT(source.frameCount() == 5);
+
+    Mat frame;
+    for (int i = 0; i < 5; ++i) {
+        CPPUNIT_ASSERT(source.nextGrayFrame(frame));
+        CPPUNIT_ASSERT(frame.rows == 48 && frame.cols == 64);
+        CPPUNIT_ASSERT(countNonZero(frame != testFrame(i)) == 0);
+        CPPUNIT_ASSERT(source.lastFrameInfo().sequenceNumber == (unsigned) (i + 1 + i / 2));
+        CPPUNIT_ASSERT(source.lastFrameInfo().resolution == Size(64, 48));
+    }
+    CPPUNIT_ASSERT(!source.nextGrayFrame(frame));
+
+    // 30 fps
+    CPPUNIT_ASSERT(source.recordedMicros(0) == 0);
+    CPPUNIT_ASSERT(abs(source.recordedMicros(3) - 100000) <= 1);
+}
+
+void RawFrameTest::testSeek() {
+    record(path, 5);
+
+    MmapFrameSource source(path);
+    Mat frame;
+
+    source.seek(3);
+    CPPUNIT_ASSERT(source.nextGrayFrame(frame));
+    CPPUNIT_ASSERT(countNonZero(frame != testFrame(3)) == 0);
+
+    // drawing into a copy of the frame must not change the replay
+    Mat drawn = frame.clone();
+    drawn.setTo(Scalar(0));
+    source.seek(3);
+    CPPUNIT_ASSERT(source.nextGrayFrame(frame));
+    CPPUNIT_ASSERT(countNonZero(frame != testFrame(3)) == 0);
+
+    // a seek back delivers the same pixels as the first pass
+    source.seek(0);
+    for (int i = 0; i < 5; ++i) {
+        CPPUNIT_ASSERT(source.nextGrayFrame(frame));
+        CPPUNIT_ASSERT(countNonZero(frame != testFrame(i)) == 0);
+    }
+
+    MmapFrameSource replay(path);
+    replay.seek(3);
+    CPPUNIT_ASSERT(replay.nextGrayFrame(frame));
+    CPPUNIT_ASSERT(countNonZero(frame != testFrame(3)) == 0);
+}
+
+void RawFrameTest::testWrongFrameSize() {
+    RawFrameRecorder recorder(path);
+    recorder.write(testFrame(0), FrameInfo());
+
+    bool thrown = false;
+    try {
+        recorder.write(Mat::zeros(10, 10, CV_8UC1), FrameInfo());
+    } catch (WrongArgumentException &e) {
+        thrown = true;
+    }
+    CPPUNIT_ASSERT(thrown);
+    CPPUNIT_ASSERT(recorder.frameCount() == 1);
+}
+
+void RawFrameTest::testInvalidFile() {
+    ofstream file(path.c_str());
+    file << "this is not a recording";
+    file.close();
+
+    bool thrown = false;
+    try {
+        MmapFrameSource source(path);
+    } catch (GazeException &e) {
+        thrown = true;
+    }
+    CPPUNIT_ASSERT(thrown);
+}
@@ -0,0 +1,39 @@
+/*
+ * File:   RawFrameTest.h
+ *
+ * Created on Oct 17, 2026, 10:12:31 AM
+ */
+
+#ifndef RAWFRAMETEST_H
+#define	RAWFRAMETEST_H
+
+#include <string>
+#include <cppunit/extensions/HelperMacros.h>
+
+class RawFrameTest : public CPPUNIT_NS::TestFixture {
+    CPPUNIT_TEST_SUITE(RawFrameTest);
+
+    CPPUNIT_TEST(testRecordAndReplay);
+    CPPUNIT_TEST(testSeek);
+    CPPUNIT_TEST(testWrongFrameSize);
+    CPPUNIT_TEST(testInvalidFile);
+
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+    RawFrameTest();
+    virtual ~RawFrameTest();
+    void setUp();
+    void tearDown();
+
+private:
+    std::string path;
+
+    void testRecordAndReplay();
+    void testSeek();
+    void testWrongFrameSize();
+    void testInvalidFile();
+
+};
+
+#endif	/* RAWFRAMETEST_H */
@@ -0,0 +1,118 @@
+/*
+ * File:   RegionPredictorTest.cpp
+ *
+ * Created on Oct 17, 2026, 1:14:36 PM
+ */
+
+#include <opencv2/core/core.hpp>
+
+#include "RegionPredictorTest.h"
+#include "detection/RegionPredictor.hpp"
+#include "config/GazeConfig.hpp"
+
+using namespace cv;
+
+CPPUNIT_TEST_SUITE_REGISTRATION(RegionPredictorTest);
+
+// the eye found by the haar classifier
+static const Rect EYE(200, 100, 160, 120);
+
+static Point2f centerOf(const Rect& region) {
+    return Point2f(region.x + region.width / 2.f, region.y + region.height / 2.f);
+}
+
+RegionPredictorTest::RegionPredictorTest() {
+}
+
+RegionPredictorTest::~RegionPredictorTest() {
+}
+
+void RegionPredictorTest::setUp() {
+}
+
+void RegionPredictorTest::tearDown() {
+}
+
+void RegionPredictorTest::testStillHead() {
+    RegionPredictor predictor;
+    predictor.reset(EYE, 1);
+
+    Point2f glints = centerOf(EYE) + Point2f(5, -3);
+    Rect region;
+    for (unsigned long i = 2; i < 40; ++i) {
+        region = predictor.predict(i);
+        predictor.correct(glints);
+    }
+
+    region = predictor.predict(40);
+
+    // the region shrinks, but not below the minimum size
+    CPPUNIT_ASSERT(region.width < EYE.width);
+    CPPUNIT_ASSERT(region.height < EYE.height);
+    CPPUNIT_ASSERT(region.width >= EYE.width * GazeConfig::REGION_MIN_SCALE_PERCENT / 100);
+    CPPUNIT_ASSERT(region.height >= EYE.height * GazeConfig::REGION_MIN_SCALE_PERCENT / 100);
+
+    // and is centered at the glints
+    CPPUNIT_ASSERT(norm(centerOf(region) - glints) <= 1);
+}
+
+void RegionPredictorTest::testConstantVelocity() {
+    RegionPredictor predictor;
+    predictor.reset(EYE, 1);
+
+    Point2f velocity(6, -2);
+    Point2f glints = centerOf(EYE);
+    for (unsigned long i = 2; i < 40; ++i) {
+        predictor.predict(i);
+        glints += velocity;
+        predictor.correct(glints);
+    }
+
+    // the glints are predicted where they will be, not where they have been
+    predictor.predict(40);
+    glints += velocity;
+    CPPUNIT_ASSERT(norm(predictor.predictedCenter() - glints) < 1);
+}
+
+void RegionPredictorTest::testMissedGlints() {
+    RegionPredictor predictor;
+    predictor.reset(EYE, 1);
+
+    Point2f glints = centerOf(EYE);
+    Rect region;
+    for (unsigned long i = 2; i < 40; ++i) {
+        region = predictor.predict(i);
+        predictor.correct(glints);
+    }
+
+    // without glints the region grows up to the maximum size
+    Rect lastRegion = region;
+    for (unsigned long i = 40; i < 80; ++i) {
+        region = predictor.predict(i);
+        CPPUNIT_ASSERT(region.width >= lastRegion.width);
+        lastRegion = region;
+    }
+
+    CPPUNIT_ASSERT(region.width > EYE.width);
+    CPPUNIT_ASSERT(region.width <= EYE.width * GazeConfig::REGION_MAX_SCALE_PERCENT / 100 + 1);
+    CPPUNIT_ASSERT(region.height <= EYE.height * GazeConfig::REGION_MAX_SCALE_PERCENT / 100 + 1);
+}
+
+void RegionPredictorTest::testDroppedFrames() {
+    RegionPredictor predictor;
+    predictor.reset(EYE, 1);
+
+    Point2f velocity(4, 0);
+    Point2f glints = centerOf(EYE);
+    for (unsigned long i = 2; i < 40; ++i) {
+        predictor.predict(i);
+        glints += velocity;
+        predictor.correct(glints);
+    }
+
+    // the source dropped 4 frames, the head moved 5 frames
+    predictor.predict(44);
+    glints += velocity * 5;
+    CPPUNIT_ASSERT(norm(predictor.predictedCenter() - glints) < 2);
+}
+
@@ -0,0 +1,36 @@
+/*
+ * File:   RegionPredictorTest.h
+ *
+ * Created on Oct 17, 2026, 1:14:36 PM
+ */
+
+#ifndef REGIONPREDICTORTEST_H
+#define	REGIONPREDICTORTEST_H
+
+#include <cppunit/extensions/HelperMacros.h>
+
+class RegionPredictorTest : public CPPUNIT_NS::TestFixture {
+    CPPUNIT_TEST_SUITE(RegionPredictorTest);
+
+    CPPUNIT_TEST(testStillHead);
+    CPPUNIT_TEST(testConstantVelocity);
+    CPPUNIT_TEST(testMissedGlints);
+    CPPUNIT_TEST(testDroppedFrames);
+
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+    RegionPredictorTest();
+    virtual ~RegionPredictorTest();
+    void setUp();
+    void tearDown();
+
+private:
+    void testStillHead();
+    void testConstantVelocity();
+    void testMissedGlints();
+    void testDroppedFrames();
+};
+
+#endif	/* REGIONPREDICTORTEST_H */
+
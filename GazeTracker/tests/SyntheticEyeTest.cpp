@@ -0,0 +1,108 @@
+/*
+ * File:   SyntheticEyeTest.cpp
+ *
+ * Created on Oct 17, 2026, 11:02:47 AM
+ */
+
+#include <opencv2/core/core.hpp>
+
+#include "SyntheticEyeTest.h"
+#include "video/SyntheticEyeSource.hpp"
+
+using namespace cv;
+
+CPPUNIT_TEST_SUITE_REGISTRATION(SyntheticEyeTest);
+
+static int intensityAt(const Mat& frame, const Point2f& point) {
+    return frame.at<uchar>(cvRound(point.y), cvRound(point.x));
+}
+
+SyntheticEyeTest::SyntheticEyeTest() {
+}
+
+SyntheticEyeTest::~SyntheticEyeTest() {
+}
+
+void SyntheticEyeTest::setUp() {
+}
+
+void SyntheticEyeTest::tearDown() {
+}
+
+void SyntheticEyeTest::testDeterministic() {
+    SyntheticEyeSource first;
+    SyntheticEyeSource second;
+
+    Mat firstFrame;
+    Mat secondFrame;
+    for (int i = 0; i < 10; ++i) {
+        CPPUNIT_ASSERT(first.nextGrayFrame(firstFrame));
+        CPPUNIT_ASSERT(second.nextGrayFrame(secondFrame));
+        CPPUNIT_ASSERT(countNonZero(firstFrame != secondFrame) == 0);
+    }
+
+    // the eye moves
+    EyeGroundTruth start = first.groundTruth(1);
+    EyeGroundTruth later = first.groundTruth(10);
+    CPPUNIT_ASSERT(start.pupilCenter != later.pupilCenter);
+}
+
+void SyntheticEyeTest::testGroundTruth() {
+    SyntheticEyeSource source;
+    Mat frame;
+
+    for (int i = 0; i < 30; ++i) {
+        CPPUNIT_ASSERT(source.nextGrayFrame(frame));
+        CPPUNIT_ASSERT(frame.type() == CV_8UC1);
+        CPPUNIT_ASSERT(frame.size() == source.getConfig().resolution);
+
+        EyeGroundTruth truth = source.groundTruth(source.lastFrameInfo().sequenceNumber);
+        CPPUNIT_ASSERT(truth.glints.size() == 4);
+
+        // a dark pupil (unless a glint covers its center), bright glints
+        // and a lighter skin
+        bool pupilCovered = false;
+        for (unsigned int g = 0; g < truth.glints.size(); ++g) {
+            CPPUNIT_ASSERT(intensityAt(frame, truth.glints.at(g)) > 200);
+            Point2f distance = truth.glints.at(g) - truth.pupilCenter;
+            pupilCovered = pupilCovered || distance.dot(distance) < 10 * 10;
+        }
+        if (!pupilCovered)
+            CPPUNIT_ASSERT(intensityAt(frame, truth.pupilCenter) < 60);
+        CPPUNIT_ASSERT(intensityAt(frame, Point2f(5, 5)) > 100);
+
+        Point2f gazeVector = truth.glintCenter - truth.pupilCenter;
+        CPPUNIT_ASSERT(gazeVector == truth.gazeVector);
+    }
+}
+
+void SyntheticEyeTest::testNumOfFrames() {
+    SyntheticEyeConfig config;
+    config.numOfFrames = 3;
+    SyntheticEyeSource source(config);
+
+    Mat frame;
+    for (int i = 1; i <= 3; ++i) {
+        CPPUNIT_ASSERT(source.nextGrayFrame(frame));
+        CPPUNIT_ASSERT(source.lastFrameInfo().sequenceNumber == (unsigned) i);
+    }
+    CPPUNIT_ASSERT(!source.nextGrayFrame(frame));
+}
+
+void SyntheticEyeTest::testRegionOfInterest() {
+    SyntheticEyeSource full;
+    SyntheticEyeSource cropped;
+
+    Rect roi(100, 50, 200, 120);
+    cropped.setRegionOfInterest(roi);
+
+    Mat fullFrame;
+    Mat croppedFrame;
+    CPPUNIT_ASSERT(full.nextGrayFrame(fullFrame));
+    CPPUNIT_ASSERT(cropped.nextGrayFrame(croppedFrame));
+
+    CPPUNIT_ASSERT(croppedFrame.size() == roi.size());
+    CPPUNIT_ASSERT(cropped.lastFrameInfo().region == roi);
+    CPPUNIT_ASSERT(cropped.lastFrameInfo().resolution == fullFrame.size());
+    CPPUNIT_ASSERT(countNonZero(croppedFrame != fullFrame(roi)) == 0);
+}
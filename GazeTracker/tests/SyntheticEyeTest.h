@@ -0,0 +1,36 @@
+/*
+ * File:   SyntheticEyeTest.h
+ *
+ * Created on Oct 17, 2026, 11:02:47 AM
+ */
+
+#ifndef SYNTHETICEYETEST_H
+#define	SYNTHETICEYETEST_H
+
+#include <cppunit/extensions/HelperMacros.h>
+
+class SyntheticEyeTest : public CPPUNIT_NS::TestFixture {
+    CPPUNIT_TEST_SUITE(SyntheticEyeTest);
+
+    CPPUNIT_TEST(testDeterministic);
+    CPPUNIT_TEST(testGroundTruth);
+    CPPUNIT_TEST(testNumOfFrames);
+    CPPUNIT_TEST(testRegionOfInterest);
+
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+    SyntheticEyeTest();
+    virtual ~SyntheticEyeTest();
+    void setUp();
+    void tearDown();
+
+private:
+    void testDeterministic();
+    void testGroundTruth();
+    void testNumOfFrames();
+    void testRegionOfInterest();
+};
+
+#endif	/* SYNTHETICEYETEST_H */
+